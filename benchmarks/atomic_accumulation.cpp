@@ -0,0 +1,80 @@
+// Compares strategies for concurrently accumulating `double3d` contributions into shared slots:
+// a mutex per slot, `atomic_vector` and `reduction_buffer`. Fewer slots means more contention.
+#include "common.h"
+#include <dandy/atomic.h>
+#include <mutex>
+#include <memory>
+
+constexpr size_t additions = 1 << 20; // per thread
+
+inline double3d contribution(const size_t thread, const size_t i)
+{
+    return { double(i & 7), double(thread), 0.5 };
+}
+
+inline size_t slot_of(const size_t thread, const size_t i, const size_t slots)
+{
+    return (i * 2654435761u + thread) % slots;
+}
+
+double bench_mutex(const size_t threads, const size_t slots)
+{
+    std::vector<double3d> data(slots);
+    std::unique_ptr<std::mutex[]> mutexes(new std::mutex[slots]);
+
+    return time_ms([&]
+    {
+        run_threads(threads, [&](const size_t t)
+        {
+            for (size_t i = 0; i < additions; i++)
+            {
+                const size_t slot = slot_of(t, i, slots);
+                std::lock_guard lock(mutexes[slot]);
+                data[slot] += contribution(t, i);
+            }
+        });
+    });
+}
+
+double bench_atomic(const size_t threads, const size_t slots)
+{
+    std::unique_ptr<atomic_vector<double, 3>[]> data(new atomic_vector<double, 3>[slots]);
+
+    return time_ms([&]
+    {
+        run_threads(threads, [&](const size_t t)
+        {
+            for (size_t i = 0; i < additions; i++)
+                data[slot_of(t, i, slots)].fetch_add(contribution(t, i), std::memory_order_relaxed);
+        });
+    });
+}
+
+double bench_reduction(const size_t threads, const size_t slots)
+{
+    std::vector<double3d> data(slots);
+    reduction_buffer<double, 3> buffer(slots, threads);
+
+    return time_ms([&]
+    {
+        run_threads(threads, [&](const size_t t)
+        {
+            double3d* local = buffer.local(t);
+
+            for (size_t i = 0; i < additions; i++)
+                local[slot_of(t, i, slots)] += contribution(t, i);
+        });
+        buffer.reduce(data.data());
+    });
+}
+
+int main()
+{
+    const size_t threads = thread_count();
+
+    std::printf("%zu threads, %zu additions per thread, lock-free: %s\n\n", threads, additions, atomic_vector<double, 3>::is_always_lock_free ? "yes" : "no");
+    std::printf("%8s %12s %12s %12s\n", "slots", "mutex ms", "atomic ms", "reduce ms");
+
+    for (const size_t slots : { 1, 16, 256, 4096, 65536 })
+        std::printf("%8zu %12.1f %12.1f %12.1f\n", slots, bench_mutex(threads, slots), bench_atomic(threads, slots), bench_reduction(threads, slots));
+}
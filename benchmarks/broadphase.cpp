@@ -0,0 +1,90 @@
+// Compares finding the overlapping pairs among moving boxes by testing all pairs with `operator<=`
+// against the sweep-and-prune broadphase of dandy/broadphase.h, on one and on several threads.
+#include "common.h"
+#include <dandy/broadphase.h>
+#include <random>
+
+constexpr size_t frames = 10;
+
+struct world
+{
+    std::vector<aabb<float, 3>> boxes;
+    std::vector<float3d> velocities;
+
+    // boxes of size 1 at a density giving a few neighbours each
+    explicit world(const size_t count) : boxes(count), velocities(count)
+    {
+        std::mt19937 rng(42);
+        const float extent = std::cbrt(float(count)) * 2.f;
+        std::uniform_real_distribution<float> position(0.f, extent), velocity(-0.05f, 0.05f);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            boxes[i].lo = { position(rng), position(rng), position(rng) };
+            boxes[i].hi = boxes[i].lo + 1.f;
+            velocities[i] = { velocity(rng), velocity(rng), velocity(rng) };
+        }
+    }
+
+    void step()
+    {
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            boxes[i].lo += velocities[i];
+            boxes[i].hi += velocities[i];
+        }
+    }
+};
+
+double bench_brute_force(world w, size_t& pairs)
+{
+    return time_ms([&]
+    {
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            for (size_t i = 0; i < w.boxes.size(); i++)
+            {
+                for (size_t j = i + 1; j < w.boxes.size(); j++)
+                    pairs += w.boxes[i].lo <= w.boxes[j].hi && w.boxes[j].lo <= w.boxes[i].hi;
+            }
+            w.step();
+        }
+    }) / frames;
+}
+
+double bench_sweep_and_prune(world w, const size_t threads, size_t& pairs)
+{
+    sweep_and_prune<float, 3> broadphase;
+    std::vector<std::pair<uint32_t, uint32_t>> out;
+
+    return time_ms([&]
+    {
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            broadphase.update(w.boxes.data(), w.boxes.size());
+            out.clear();
+            broadphase.find_pairs(out, threads);
+            pairs += out.size();
+            w.step();
+        }
+    }) / frames;
+}
+
+int main()
+{
+    const size_t threads = thread_count();
+
+    std::printf("%zu frames, ms per frame\n\n", frames);
+    std::printf("%-10s %14s %14s %14s\n", "bodies", "all pairs", "sap", "sap threaded");
+
+    for (const size_t count : { size_t(10000), size_t(200000) })
+    {
+        const world w(count);
+        size_t pairs[3] = {};
+        const double brute = count <= 10000 ? bench_brute_force(w, pairs[0]) : 0;
+        const double single = bench_sweep_and_prune(w, 1, pairs[1]);
+        const double threaded = bench_sweep_and_prune(w, threads, pairs[2]);
+
+        std::printf("%-10zu %14.2f %14.2f %14.2f   (pairs %zu %zu %zu)\n", count, brute, single, threaded, pairs[0], pairs[1], pairs[2]);
+    }
+}
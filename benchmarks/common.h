@@ -0,0 +1,35 @@
+#pragma once
+#include <dandy/dandy.h>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+using namespace dd;
+
+/// @brief Measures the wall time of a callable in milliseconds
+template<class Fn>
+inline double time_ms(const Fn& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/// @brief Runs a callable on `threads` threads, passing each its thread index
+template<class Fn>
+inline void run_threads(const size_t threads, const Fn& fn)
+{
+    std::vector<std::thread> pool;
+
+    for (size_t t = 0; t < threads; t++)
+        pool.emplace_back(fn, t);
+    for (std::thread& thread : pool)
+        thread.join();
+}
+
+/// @brief Gets the number of threads to benchmark with
+inline size_t thread_count()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 2);
+}
@@ -0,0 +1,25 @@
+// Stress translation unit for the compile-time benchmark: deep expression trees, shaped like
+// the output of code generators, over several vector types. Every step adds five operations
+// to the tree, so each instantiation of `deep` builds a tree of 160 operations.
+#include <dandy/dandy.h>
+
+using namespace dd;
+
+#define STEP(x)    (min((x) * s + a - b / s, a).lerp(b, s))
+#define STEP4(x)   STEP(STEP(STEP(STEP(x))))
+#define STEP16(x)  STEP4(STEP4(STEP4(STEP4(x))))
+
+template<class Vector>
+Vector deep(const Vector& a, const Vector& b, const typename Vector::scalar_t s)
+{
+    return STEP16(STEP16(a));
+}
+
+template float2d  deep(const float2d&,  const float2d&,  float);
+template float3d  deep(const float3d&,  const float3d&,  float);
+template float4d  deep(const float4d&,  const float4d&,  float);
+template double2d deep(const double2d&, const double2d&, double);
+template double3d deep(const double3d&, const double3d&, double);
+template double4d deep(const double4d&, const double4d&, double);
+template int3d    deep(const int3d&,    const int3d&,    int);
+template long4d   deep(const long4d&,   const long4d&,   int64_t);
@@ -0,0 +1,89 @@
+// Compiler launcher for the compile-time benchmark. Runs a compiler command, reports its wall time
+// and peak memory, and fails the compilation when either exceeds its budget (0 disables a budget).
+// The object file of a compilation over budget is removed, so that the build keeps failing.
+//
+// usage: launcher <max seconds> <max megabytes> <compiler> <arguments...>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::fprintf(stderr, "usage: %s <max seconds> <max megabytes> <compiler> <arguments...>\n", argv[0]);
+        return 2;
+    }
+    const double max_seconds = std::atof(argv[1]);
+    const double max_megabytes = std::atof(argv[2]);
+    const auto start = std::chrono::steady_clock::now();
+    double megabytes = 0; // not measured on Windows
+    int status;
+
+#ifdef _WIN32
+    status = static_cast<int>(_spawnvp(_P_WAIT, argv[3], argv + 3));
+#else
+    pid_t pid;
+
+    if (posix_spawnp(&pid, argv[3], nullptr, nullptr, argv + 3, environ) != 0)
+    {
+        std::perror(argv[3]);
+        return 2;
+    }
+    int wait_status;
+    rusage usage;
+
+    wait4(pid, &wait_status, 0, &usage);
+    status = WIFEXITED(wait_status) ? WEXITSTATUS(wait_status) : 1;
+#ifdef __APPLE__
+    megabytes = usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+    megabytes = usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+#endif
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const char* source = "";
+    const char* object = nullptr;
+
+    for (int i = 4; i < argc; i++)
+    {
+        const size_t length = std::strlen(argv[i]);
+
+        if (length > 4 && std::strcmp(argv[i] + length - 4, ".cpp") == 0)
+            source = argv[i];
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            object = argv[i + 1];
+    }
+    std::printf("%s: %.2f s, %.0f MB\n", source, seconds, megabytes);
+    std::fflush(stdout);
+
+    if (status != 0)
+        return status;
+
+    const bool over_time = max_seconds > 0 && seconds > max_seconds;
+    const bool over_memory = max_megabytes > 0 && megabytes > max_megabytes;
+
+    if (over_time)
+        std::fprintf(stderr, "%s: compile time exceeds the budget of %.2f s\n", source, max_seconds);
+    if (over_memory)
+        std::fprintf(stderr, "%s: compile memory exceeds the budget of %.0f MB\n", source, max_megabytes);
+    if (over_time || over_memory)
+    {
+        if (object)
+            std::remove(object);
+        return 1;
+    }
+    return 0;
+}
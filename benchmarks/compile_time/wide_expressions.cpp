@@ -0,0 +1,29 @@
+// Stress translation unit for the compile-time benchmark: many shallow expressions over all
+// non-boolean vector types, exercising the operators, functions and traits in breadth
+#include <dandy/dandy.h>
+
+using namespace dd;
+
+template<class Vector>
+Vector wide(const Vector& a, const Vector& b, const typename Vector::scalar_t s)
+{
+    Vector out = a + b;
+
+    out += a - b * s;
+    out += (a * b) / (b + 1);
+    out += min(a, b) - max(a, s);
+    out += clamp(a, b, a + b).lerp(b, s);
+    out += -(a - b) * s + s * (b - a);
+    out += (a * a) * b.dot(a);
+    out -= (out + a) * (out - b);
+    return out;
+}
+
+#define INSTANTIATE(type) template type wide(const type&, const type&, traits::scalar_t<type>);
+
+INSTANTIATE(char2d)  INSTANTIATE(uchar2d)  INSTANTIATE(int2d)  INSTANTIATE(uint2d)
+INSTANTIATE(long2d)  INSTANTIATE(ulong2d)  INSTANTIATE(float2d)  INSTANTIATE(double2d)
+INSTANTIATE(char3d)  INSTANTIATE(uchar3d)  INSTANTIATE(int3d)  INSTANTIATE(uint3d)
+INSTANTIATE(long3d)  INSTANTIATE(ulong3d)  INSTANTIATE(float3d)  INSTANTIATE(double3d)
+INSTANTIATE(char4d)  INSTANTIATE(uchar4d)  INSTANTIATE(int4d)  INSTANTIATE(uint4d)
+INSTANTIATE(long4d)  INSTANTIATE(ulong4d)  INSTANTIATE(float4d)  INSTANTIATE(double4d)
@@ -0,0 +1,64 @@
+// Compares building the convex hull of points in a disc and in a ball from all the points, with
+// Andrew's monotone chain and quickhull directly, against dd::convex_hull, which first discards the
+// points inside the hull of the extreme points, on one and on several threads.
+#include "common.h"
+#include <dandy/hull.h>
+#include <dandy/random.h>
+#include <numeric>
+
+constexpr size_t count = 1 << 22;
+
+template<class Vector>
+std::vector<Vector> random_in_ball(xoshiro256x<>& rng)
+{
+    std::vector<Vector> points;
+    points.reserve(count);
+
+    while (points.size() < count)
+    {
+        Vector p;
+        random_in_box(rng, &p, 1);
+        p = p * 2.0 - 1.0;
+
+        if (p.length2() <= 1)
+            points.push_back(p);
+    }
+    return points;
+}
+
+template<class Hull, class Fn>
+void report(const char* name, Hull& hull, const Fn& fn)
+{
+    const double ms = time_ms(fn);
+    std::printf("%-22s %10.1f ms %10zu hull elements\n", name, ms, hull.size());
+}
+
+int main()
+{
+    xoshiro256x<> rng(42);
+    const std::vector<double2d> disc = random_in_ball<double2d>(rng);
+    const std::vector<double3d> ball = random_in_ball<double3d>(rng);
+
+    std::printf("%zu points\n\n", count);
+
+    std::vector<uint32_t> polygon;
+    report("monotone chain", polygon, [&]
+    {
+        std::vector<uint32_t> indices(count);
+        std::iota(indices.begin(), indices.end(), 0u);
+        impl::_monotone_chain(disc.data(), indices, polygon);
+    });
+    report("2d filtered", polygon, [&] { convex_hull(disc.data(), count, polygon); });
+    report("2d filtered threaded", polygon, [&] { convex_hull(disc.data(), count, polygon, thread_count()); });
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    std::printf("\n");
+    report("quickhull", triangles, [&]
+    {
+        std::vector<uint32_t> indices(count);
+        std::iota(indices.begin(), indices.end(), 0u);
+        impl::_quickhull<double>(ball.data()).run(indices, triangles);
+    });
+    report("3d filtered", triangles, [&] { convex_hull(ball.data(), count, triangles); });
+    report("3d filtered threaded", triangles, [&] { convex_hull(ball.data(), count, triangles, thread_count()); });
+}
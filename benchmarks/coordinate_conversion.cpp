@@ -0,0 +1,75 @@
+// Compares converting a scan of float3d points to spherical coordinates and back with per-point
+// calls to std::sqrt, std::atan2, std::sin and std::cos, against the members to_spherical and
+// from_spherical, and the array kernels in their precise and fast modes.
+#include "common.h"
+#include <dandy/random.h>
+#include <cmath>
+
+constexpr size_t points = 1 << 22;
+constexpr size_t repeats = 10;
+
+template<class Fn>
+void report(const char* name, const std::vector<float3d>& out, const Fn& fn)
+{
+    double checksum = 0;
+    const double ms = time_ms([&]
+    {
+        for (size_t r = 0; r < repeats; r++)
+        {
+            fn();
+            checksum += out[r * 997].x + out[r * 997].y + out[r * 997].z;
+        }
+    });
+    std::printf("%-24s %10.1f ms %10.1f M points/s   (checksum %.3f)\n", name, ms, double(points * repeats) / ms / 1e3, checksum);
+}
+
+int main()
+{
+    xoshiro256x<> rng(42);
+    std::vector<float3d> scan(points), spherical(points), cartesian(points);
+    random_in_box(rng, scan.data(), points);
+
+    std::printf("%zu points, %zu repeats\n\n", points, repeats);
+
+    report("to spherical libm", spherical, [&]
+    {
+        for (size_t i = 0; i < points; i++)
+        {
+            const float3d& p = scan[i];
+            const float planar = std::sqrt(p.x * p.x + p.y * p.y);
+
+            spherical[i] = float3d(std::sqrt(planar * planar + p.z * p.z), std::atan2(planar, p.z), std::atan2(p.y, p.x));
+        }
+    });
+    report("to spherical member", spherical, [&]
+    {
+        for (size_t i = 0; i < points; i++)
+            spherical[i] = scan[i].to_spherical();
+    });
+    report("to spherical member fast", spherical, [&]
+    {
+        for (size_t i = 0; i < points; i++)
+            spherical[i] = scan[i].to_spherical(dd::fast);
+    });
+    report("to spherical array", spherical, [&] { to_spherical(scan.data(), spherical.data(), points); });
+    report("to spherical array fast", spherical, [&] { to_spherical(scan.data(), spherical.data(), points, dd::fast); });
+
+    std::printf("\n");
+    report("from spherical libm", cartesian, [&]
+    {
+        for (size_t i = 0; i < points; i++)
+        {
+            const float3d& s = spherical[i];
+            const float planar = s.x * std::sin(s.y);
+
+            cartesian[i] = float3d(planar * std::cos(s.z), planar * std::sin(s.z), s.x * std::cos(s.y));
+        }
+    });
+    report("from spherical member", cartesian, [&]
+    {
+        for (size_t i = 0; i < points; i++)
+            cartesian[i] = float3d::from_spherical(spherical[i]);
+    });
+    report("from spherical array", cartesian, [&] { from_spherical(spherical.data(), cartesian.data(), points); });
+    report("from spherical array fast", cartesian, [&] { from_spherical(spherical.data(), cartesian.data(), points, dd::fast); });
+}
@@ -0,0 +1,73 @@
+// Compares evaluating a cubic Bézier curve of float3d at many parameters with a chain of lerps into
+// temporaries (de Casteljau), against the fused expression of dd::cubic_bezier per sample and its
+// batch evaluation across samples, on one and on several threads; and likewise for a Catmull-Rom
+// spline through many points.
+#include "common.h"
+#include <dandy/curve.h>
+#include <dandy/random.h>
+
+constexpr size_t samples = 1 << 22;
+constexpr size_t repeats = 10;
+
+template<class Fn>
+void report(const char* name, const std::vector<float3d>& out, const Fn& fn)
+{
+    double checksum = 0;
+    const double ms = time_ms([&]
+    {
+        for (size_t r = 0; r < repeats; r++)
+        {
+            fn();
+            checksum += out[r * 997].x + out[r * 997].y + out[r * 997].z;
+        }
+    });
+    std::printf("%-22s %10.1f ms %10.1f M samples/s   (checksum %.3f)\n", name, ms, double(samples * repeats) / ms / 1e3, checksum);
+}
+
+int main()
+{
+    xoshiro256x<> rng(42);
+    std::vector<float> t(samples);
+    std::vector<float3d> out(samples);
+
+    for (float& u : t)
+        u = float(rng() >> 40) * 0x1.0p-24f;
+
+    cubic_bezier<float, 3> curve;
+    random_in_box(rng, curve.points.data(), 4);
+
+    std::printf("%zu samples, %zu repeats\n\n", samples, repeats);
+
+    report("bezier lerp chain", out, [&]
+    {
+        for (size_t i = 0; i < samples; i++)
+        {
+            const float3d a = curve.points[0].lerp(curve.points[1], t[i]), b = curve.points[1].lerp(curve.points[2], t[i]), c = curve.points[2].lerp(curve.points[3], t[i]);
+            const float3d ab = a.lerp(b, t[i]), bc = b.lerp(c, t[i]);
+            out[i] = ab.lerp(bc, t[i]);
+        }
+    });
+    report("bezier per sample", out, [&]
+    {
+        for (size_t i = 0; i < samples; i++)
+            out[i] = curve(t[i]);
+    });
+    report("bezier batch", out, [&] { curve.evaluate(t.data(), samples, out.data()); });
+    report("bezier batch threaded", out, [&] { curve.evaluate(t.data(), samples, out.data(), thread_count()); });
+
+    std::vector<float3d> points(1000);
+    random_in_box(rng, points.data(), points.size());
+    const catmull_rom_spline<float, 3> spline(points.data(), points.size());
+
+    for (float& u : t)
+        u *= spline.domain();
+
+    std::printf("\n");
+    report("spline per sample", out, [&]
+    {
+        for (size_t i = 0; i < samples; i++)
+            out[i] = spline(t[i]);
+    });
+    report("spline batch", out, [&] { spline.evaluate(t.data(), samples, out.data()); });
+    report("spline batch threaded", out, [&] { spline.evaluate(t.data(), samples, out.data(), thread_count()); });
+}
@@ -0,0 +1,92 @@
+// Compares plain Lloyd iterations, comparing every point with every centroid, against dd::kmeans of
+// dandy/kmeans.h, which skips most comparisons through Hamerly's bounds, on one and on several threads.
+#include "common.h"
+#include <dandy/kmeans.h>
+
+constexpr size_t points = 1 << 20;
+constexpr size_t clusters = 64;
+constexpr size_t iterations = 20;
+
+double bench_lloyd(const std::vector<float3d>& data, std::vector<float3d> centroids, double& checksum)
+{
+    std::vector<uint32_t> labels(data.size());
+
+    const double ms = time_ms([&]
+    {
+        for (size_t iteration = 0; iteration < iterations; iteration++)
+        {
+            std::vector<double3d> sums(clusters);
+            std::vector<size_t> counts(clusters);
+
+            for (size_t i = 0; i < data.size(); i++)
+            {
+                float nearest = std::numeric_limits<float>::infinity();
+
+                for (uint32_t j = 0; j < clusters; j++)
+                {
+                    const float distance2 = data[i].distance2(centroids[j]);
+
+                    if (distance2 < nearest)
+                    {
+                        nearest = distance2;
+                        labels[i] = j;
+                    }
+                }
+                sums[labels[i]] += data[i];
+                counts[labels[i]]++;
+            }
+            for (size_t j = 0; j < clusters; j++)
+            {
+                if (counts[j])
+                    centroids[j] = (sums[j] / double(counts[j])).scalar_cast<float>();
+            }
+        }
+    });
+
+    for (const float3d& c : centroids)
+        checksum += c.x + c.y + c.z;
+    return ms;
+}
+
+double bench_kmeans(const std::vector<float3d>& data, const size_t threads, double& checksum)
+{
+    kmeans_options options;
+    options.max_iterations = iterations;
+    options.seed = 1;
+    options.threads = threads;
+    kmeans_result<float, 3> result;
+
+    const double ms = time_ms([&] { result = kmeans(data.data(), data.size(), clusters, options); });
+
+    for (const float3d& c : result.centroids)
+        checksum += c.x + c.y + c.z;
+    return ms;
+}
+
+int main()
+{
+    std::vector<float3d> data(points), centers(clusters);
+    xoshiro256x<> rng(42);
+
+    random_in_box(rng, centers.data(), clusters, float3d::zero, float3d(100, 100, 100));
+    random_gaussian(rng, data.data(), points, float3d::zero, 4.f);
+
+    for (size_t i = 0; i < points; i++)
+        data[i] += centers[i % clusters];
+
+    // the plain iterations start from the same k-means++ seeds
+    kmeans_options seeding;
+    seeding.max_iterations = 0;
+    seeding.seed = 1;
+    const std::vector<float3d> seeds = kmeans(data.data(), points, clusters, seeding).centroids;
+
+    const size_t threads = thread_count();
+    double checksums[3] = {};
+    const double times[3] = { bench_lloyd(data, seeds, checksums[0]), bench_kmeans(data, 1, checksums[1]), bench_kmeans(data, threads, checksums[2]) };
+    const char* names[3] = { "lloyd", "kmeans", "kmeans threaded" };
+
+    std::printf("%zu points, %zu clusters, %zu iterations, %zu threads\n\n", points, clusters, iterations, threads);
+
+    for (size_t i = 0; i < 3; i++)
+        std::printf("%-16s %10.1f ms   (checksum %.3f)\n", names[i], times[i], checksums[i]);
+}
@@ -0,0 +1,70 @@
+// Compares counting the neighbours of every particle within a radius by testing all pairs against
+// building the spatial hash of dandy/grid.h and querying it, as in a step of an SPH simulation.
+#include "common.h"
+#include <dandy/grid.h>
+#include <dandy/random.h>
+
+// the radius giving each particle about 30 neighbours, as in SPH: 30 = 4/3 pi r^3 count
+float neighbour_radius(const size_t count)
+{
+    return std::cbrt(30.f / (4.18879f * float(count)));
+}
+
+double bench_brute_force(const std::vector<float3d>& positions, size_t& neighbours)
+{
+    const float radius = neighbour_radius(positions.size());
+
+    return time_ms([&]
+    {
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            for (size_t j = 0; j < positions.size(); j++)
+                neighbours += positions[i].distance2(positions[j]) <= radius * radius;
+        }
+    });
+}
+
+double bench_grid(const std::vector<float3d>& positions, const size_t threads, size_t& neighbours, double& build_ms)
+{
+    const float radius = neighbour_radius(positions.size());
+    spatial_grid<float, 3> grid(radius);
+    std::vector<size_t> counts(positions.size());
+
+    build_ms = time_ms([&] { grid.build(positions.data(), positions.size(), threads); });
+
+    // the particles are queried in the storage order of the grid, where those of a cell are adjacent
+    return build_ms + time_ms([&]
+    {
+        parallel_for(positions.size(), 1024, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            for (size_t k = first; k < last; k++)
+                grid.for_each_in_radius(grid.positions()[k], radius, [&](const float3d&, uint32_t, float) { counts[k]++; });
+        });
+        for (const size_t count : counts)
+            neighbours += count;
+    });
+}
+
+int main()
+{
+    const size_t threads = thread_count();
+    xoshiro256x<> rng(42);
+
+    std::printf("about 30 neighbours per particle in the unit cube, ms (build ms)\n\n");
+    std::printf("%-10s %14s %20s %20s\n", "particles", "all pairs", "grid", "grid threaded");
+
+    for (const size_t count : { size_t(20000), size_t(1000000) })
+    {
+        std::vector<float3d> positions(count);
+        random_in_box(rng, positions.data(), count);
+
+        size_t neighbours[3] = {};
+        double builds[2] = {};
+        const double brute = count <= 20000 ? bench_brute_force(positions, neighbours[0]) : 0;
+        const double single = bench_grid(positions, 1, neighbours[1], builds[0]);
+        const double threaded = bench_grid(positions, threads, neighbours[2], builds[1]);
+
+        std::printf("%-10zu %14.1f %11.1f (%6.1f) %11.1f (%6.1f)   (neighbours %zu %zu %zu)\n", count, brute, single, builds[0], threaded, builds[1],
+                    neighbours[0], neighbours[1], neighbours[2]);
+    }
+}
@@ -0,0 +1,54 @@
+// Compares computing all-pairs squared distances pair by pair through the expression API against the
+// tiled kernel of dandy/pairwise.h, for small and large vectors, on one and on several threads.
+#include "common.h"
+#include <dandy/pairwise.h>
+#include <dandy/random.h>
+
+template<size_t Size>
+void bench(const size_t rows, const size_t columns)
+{
+    using vector_t = vector<float, Size>;
+    std::vector<vector_t> a(rows), b(columns);
+    std::vector<float> out(rows * columns);
+    xoshiro256x<> rng(42);
+
+    random_in_box(rng, a.data(), rows);
+    random_in_box(rng, b.data(), columns);
+
+    const auto checksum = [&]
+    {
+        double sum = 0;
+
+        for (const float d : out)
+            sum += d;
+        return sum;
+    };
+
+    const double pairs = time_ms([&]
+    {
+        for (size_t i = 0; i < rows; i++)
+        {
+            for (size_t j = 0; j < columns; j++)
+                out[i * columns + j] = a[i].distance2(b[j]);
+        }
+    });
+    const double pairs_sum = checksum();
+    const double tiled = time_ms([&] { pairwise_distance2(a.data(), rows, b.data(), columns, out.data()); });
+    const double tiled_sum = checksum();
+    const double threaded = time_ms([&] { pairwise_distance2(a.data(), rows, b.data(), columns, out.data(), thread_count()); });
+
+    std::printf("%-6zu %14.1f %14.1f %14.1f   (checksums %.6g %.6g %.6g)\n", Size, pairs, tiled, threaded, pairs_sum, tiled_sum, checksum());
+}
+
+int main()
+{
+    std::printf("%zu x %zu pairs, ms\n\n", size_t(4096), size_t(4096));
+    std::printf("%-6s %14s %14s %14s\n", "size", "pair by pair", "tiled", "tiled threaded");
+
+    bench<2>(4096, 4096);
+    bench<3>(4096, 4096);
+    bench<4>(4096, 4096);
+    bench<8>(4096, 4096);
+    bench<16>(4096, 4096);
+    bench<64>(1024, 1024);
+}
@@ -0,0 +1,72 @@
+// Compares stepping particles stored as arrays of vectors, one particle at a time through the
+// expression API, against the fused structure of arrays step of dandy/particles.h, on one and on
+// several threads.
+#include "common.h"
+#include <dandy/particles.h>
+#include <dandy/random.h>
+
+constexpr size_t particles = 1 << 20;
+constexpr size_t steps = 50;
+constexpr float dt = 0.001f;
+constexpr float drag = 0.1f;
+
+const float3d gravity(0, -9.81f, 0);
+
+double bench_arrays(const std::vector<float3d>& start, double& checksum)
+{
+    std::vector<float3d> x = start, v(particles), f(particles, float3d(0, 1, 0));
+
+    const double ms = time_ms([&]
+    {
+        for (size_t step = 0; step < steps; step++)
+        {
+            for (size_t i = 0; i < particles; i++)
+            {
+                v[i] += (f[i] - v[i] * drag + gravity) * dt;
+                x[i] += v[i] * dt;
+            }
+        }
+    });
+
+    for (const float3d& p : x)
+        checksum += p.y;
+    return ms;
+}
+
+double bench_system(const std::vector<float3d>& start, const size_t threads, double& checksum)
+{
+    particle_system<float, 3> system(particles);
+
+    for (size_t i = 0; i < particles; i++)
+    {
+        system.set_position(i, start[i]);
+        system.set_force(i, float3d(0, 1, 0));
+    }
+
+    const auto acceleration = [](const float3d&, const float3d& v, const float3d& f) -> float3d { return f - v * drag + gravity; };
+    const double ms = time_ms([&]
+    {
+        for (size_t step = 0; step < steps; step++)
+            system.step(dt, acceleration, integrator::semi_implicit_euler, threads);
+    });
+
+    for (size_t i = 0; i < particles; i++)
+        checksum += system.positions(1)[i];
+    return ms;
+}
+
+int main()
+{
+    std::vector<float3d> start(particles);
+    xoshiro256x<> rng(42);
+    random_in_box(rng, start.data(), particles);
+
+    double checksums[3] = {};
+    const double times[3] = { bench_arrays(start, checksums[0]), bench_system(start, 1, checksums[1]), bench_system(start, thread_count(), checksums[2]) };
+    const char* names[3] = { "vector arrays", "particle_system", "threaded" };
+
+    std::printf("%zu particles, %zu steps\n\n", particles, steps);
+
+    for (size_t i = 0; i < 3; i++)
+        std::printf("%-16s %10.1f ms   (checksum %.3f)\n", names[i], times[i], checksums[i]);
+}
@@ -0,0 +1,79 @@
+// Compares transforming a text point dump with iostream extraction and insertion, one vector at a
+// time, against the chunked and threaded dd::pipeline of dandy/pipeline.h, from text to text and from
+// binary to binary. The dumps are held in memory, so this measures parsing, formatting and the
+// overlap of the stages rather than the disk.
+#include "common.h"
+#include <dandy/pipeline.h>
+#include <dandy/random.h>
+#include <sstream>
+
+constexpr size_t points = 1 << 20;
+
+const float3d scale(2, 2, 2);
+const float3d offset(1, -1, 0.5f);
+
+float3d transform(const float3d& v)
+{
+    return v * scale + offset;
+}
+
+double bench_streams(const std::string& text, size_t& bytes)
+{
+    std::istringstream in(text);
+    std::ostringstream out;
+
+    const double ms = time_ms([&]
+    {
+        float3d v;
+
+        while (in >> v.x >> v.y >> v.z)
+        {
+            const float3d result = transform(v);
+            out << result.x << ' ' << result.y << ' ' << result.z << '\n';
+        }
+    });
+
+    bytes = out.str().size();
+    return ms;
+}
+
+double bench_pipeline(const std::string& input, const stream_format format, const size_t threads, size_t& bytes)
+{
+    std::istringstream in(input);
+    std::ostringstream out;
+    pipeline<float, 3> p(65536, threads);
+    p.then(transform);
+
+    const double ms = time_ms([&] { p.run(in, format, out, format); });
+
+    bytes = out.str().size();
+    return ms;
+}
+
+int main()
+{
+    std::vector<float3d> vectors(points);
+    xoshiro256x<> rng(42);
+    random_in_box(rng, vectors.data(), points);
+
+    std::ostringstream text;
+
+    for (const float3d& v : vectors)
+        text << v.x << ' ' << v.y << ' ' << v.z << '\n';
+
+    const std::string binary(reinterpret_cast<const char*>(vectors.data()), points * sizeof(float3d));
+
+    size_t bytes[4] = {};
+    const double times[4] = {
+        bench_streams(text.str(), bytes[0]),
+        bench_pipeline(text.str(), stream_format::text, 1, bytes[1]),
+        bench_pipeline(binary, stream_format::binary, 1, bytes[2]),
+        bench_pipeline(binary, stream_format::binary, thread_count(), bytes[3]),
+    };
+    const char* names[4] = { "iostream text", "pipeline text", "pipeline binary", "binary threaded" };
+
+    std::printf("%zu points, %zu bytes of text\n\n", points, text.str().size());
+
+    for (size_t i = 0; i < 4; i++)
+        std::printf("%-16s %10.1f ms   (%zu bytes out)\n", names[i], times[i], bytes[i]);
+}
@@ -0,0 +1,54 @@
+// Compares generating random `float3d` samples with `std::mt19937` per component against the
+// bulk generators and distributions of dandy/random.h, on one thread and with one stream per thread.
+#include "common.h"
+#include <dandy/random.h>
+#include <random>
+
+constexpr size_t samples = 1 << 24;
+
+double bench_mt19937(std::vector<float3d>& out)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    return time_ms([&]
+    {
+        for (float3d& v : out)
+            v = { dist(rng), dist(rng), dist(rng) };
+    });
+}
+
+template<class Fn>
+double bench_dandy(std::vector<float3d>& out, const size_t threads, const Fn& fn)
+{
+    const size_t chunk = (out.size() + threads - 1) / threads;
+
+    return time_ms([&]
+    {
+        run_threads(threads, [&](const size_t t)
+        {
+            const size_t first = std::min(t * chunk, out.size());
+            xoshiro256x<> rng(42, t);
+            fn(rng, out.data() + first, std::min(chunk, out.size() - first));
+        });
+    });
+}
+
+int main()
+{
+    std::vector<float3d> out(samples);
+    const size_t threads = thread_count();
+
+    const auto box = [](auto& rng, float3d* out, const size_t count) { random_in_box(rng, out, count, float3d(-1), float3d(1)); };
+    const auto ball = [](auto& rng, float3d* out, const size_t count) { random_in_ball(rng, out, count); };
+    const auto sphere = [](auto& rng, float3d* out, const size_t count) { random_on_sphere(rng, out, count); };
+    const auto gaussian = [](auto& rng, float3d* out, const size_t count) { random_gaussian(rng, out, count); };
+
+    std::printf("%zu float3d samples\n\n", samples);
+    std::printf("%-26s %12s %12s\n", "", "1 thread ms", "threads ms");
+    std::printf("%-26s %12.1f\n", "mt19937 per component", bench_mt19937(out));
+    std::printf("%-26s %12.1f %12.1f\n", "random_in_box", bench_dandy(out, 1, box), bench_dandy(out, threads, box));
+    std::printf("%-26s %12.1f %12.1f\n", "random_in_ball", bench_dandy(out, 1, ball), bench_dandy(out, threads, ball));
+    std::printf("%-26s %12.1f %12.1f\n", "random_on_sphere", bench_dandy(out, 1, sphere), bench_dandy(out, threads, sphere));
+    std::printf("%-26s %12.1f %12.1f\n", "random_gaussian", bench_dandy(out, 1, gaussian), bench_dandy(out, threads, gaussian));
+}
@@ -0,0 +1,86 @@
+// Compares intersecting rays with triangles one ray at a time through the expression API against
+// the packet kernels of dandy/ray.h, finding the closest hit of every ray among all triangles.
+#include "common.h"
+#include <dandy/ray.h>
+#include <random>
+
+constexpr size_t rays = 1 << 14;
+constexpr size_t triangles = 256;
+
+struct scene
+{
+    std::vector<float3d> origins, directions, vertices;
+
+    scene() : origins(rays), directions(rays), vertices(3 * triangles)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+        for (size_t i = 0; i < rays; i++)
+        {
+            origins[i] = { dist(rng), dist(rng), -2.f };
+            directions[i] = { dist(rng) * 0.1f, dist(rng) * 0.1f, 1.f };
+        }
+        for (float3d& v : vertices)
+            v = { dist(rng), dist(rng), dist(rng) };
+    }
+};
+
+double bench_scalar(const scene& s, float& checksum)
+{
+    return time_ms([&]
+    {
+        for (size_t r = 0; r < rays; r++)
+        {
+            float closest = std::numeric_limits<float>::infinity();
+
+            for (size_t i = 0; i < triangles; i++)
+            {
+                const float3d& v0 = s.vertices[3 * i];
+                const float3d e1 = s.vertices[3 * i + 1] - v0, e2 = s.vertices[3 * i + 2] - v0;
+                const float3d p = s.directions[r].cross(e2);
+                const float det = e1.dot(p);
+                const float3d o = s.origins[r] - v0;
+                const float3d q = o.cross(e1);
+                const float u = o.dot(p) / det, v = s.directions[r].dot(q) / det, t = e2.dot(q) / det;
+
+                if (det != 0 && u >= 0 && v >= 0 && u + v <= 1 && t > 0 && t < closest)
+                    closest = t;
+            }
+            checksum += closest < std::numeric_limits<float>::infinity() ? closest : 0;
+        }
+    });
+}
+
+template<size_t Lanes>
+double bench_packet(const scene& s, float& checksum)
+{
+    return time_ms([&]
+    {
+        for (size_t r = 0; r < rays; r += Lanes)
+        {
+            const ray_packet<float, Lanes> packet(&s.origins[r], &s.directions[r]);
+            packet_hit<float, Lanes> hit;
+
+            for (size_t i = 0; i < triangles; i++)
+                intersect_triangle(packet, s.vertices[3 * i], s.vertices[3 * i + 1], s.vertices[3 * i + 2], hit);
+            for (const float t : hit.t)
+                checksum += t < std::numeric_limits<float>::infinity() ? t : 0;
+        }
+    });
+}
+
+int main()
+{
+    const scene s;
+    float checksums[4] = {};
+
+    std::printf("%zu rays, %zu triangles\n\n", rays, triangles);
+    std::printf("%-12s %12s %12s\n", "", "ms", "Mrays*tri/s");
+
+    const double times[4] = { bench_scalar(s, checksums[0]), bench_packet<4>(s, checksums[1]), bench_packet<8>(s, checksums[2]), bench_packet<16>(s, checksums[3]) };
+    const char* names[4] = { "scalar", "packet 4", "packet 8", "packet 16" };
+
+    for (size_t i = 0; i < 4; i++)
+        std::printf("%-12s %12.1f %12.1f   (checksum %.3f)\n", names[i], times[i], rays * triangles / times[i] / 1e3, checksums[i]);
+}
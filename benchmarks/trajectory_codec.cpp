@@ -0,0 +1,100 @@
+// Compares the size and decoding speed of trajectories of double3d positions stored by
+// dandy/trajectory.h, quantized and exact, against copying the raw arrays, as when replaying a
+// recording of entities moving smoothly with some noise.
+#include "common.h"
+#include <dandy/random.h>
+#include <dandy/trajectory.h>
+
+constexpr size_t entities = 256;
+constexpr size_t ticks = 4096;
+constexpr size_t repeats = 10;
+
+std::vector<std::vector<double3d>> record()
+{
+    std::vector<std::vector<double3d>> out(entities, std::vector<double3d>(ticks));
+    xoshiro256 rng(42);
+
+    for (std::vector<double3d>& path : out)
+    {
+        double3d position, velocity;
+        random_in_box(rng, &position, 1, double3d(-1000, -1000, -1000), double3d(1000, 1000, 1000));
+        random_in_box(rng, &velocity, 1, double3d(-5, -5, -5), double3d(5, 5, 5));
+
+        for (double3d& p : path)
+        {
+            double3d noise;
+            random_in_box(rng, &noise, 1, double3d(-0.5, -0.5, -0.5), double3d(0.5, 0.5, 0.5));
+
+            velocity += noise * 0.05;
+            position += velocity * (1 / 60.);
+            p = position;
+        }
+    }
+    return out;
+}
+
+void bench_raw(const std::vector<std::vector<double3d>>& paths)
+{
+    std::vector<double3d> out(ticks);
+    double checksum = 0;
+
+    const double ms = time_ms([&]
+    {
+        for (size_t r = 0; r < repeats; r++)
+        {
+            for (const std::vector<double3d>& path : paths)
+            {
+                std::copy(path.begin(), path.end(), out.begin());
+                checksum += out[r].x;
+            }
+        }
+    });
+    const double bytes = double(entities * ticks * sizeof(double3d));
+
+    std::printf("%-12s %10.0f KiB %8.1fx %10.1f ms %8.2f GB/s   (checksum %.3f)\n", "raw", bytes / 1024, 1., ms, bytes * repeats / ms / 1e6, checksum);
+}
+
+void bench_codec(const char* name, const std::vector<std::vector<double3d>>& paths, const double quantum, const trajectory_predictor predictor)
+{
+    std::vector<compressed_trajectory<double, 3>> trajectories(entities, compressed_trajectory<double, 3>(quantum, predictor));
+    size_t compressed = 0;
+
+    for (size_t e = 0; e < entities; e++)
+    {
+        trajectories[e].append(paths[e].data(), ticks);
+        compressed += trajectories[e].bytes();
+    }
+
+    std::vector<double3d> out(ticks);
+    double checksum = 0;
+
+    const double ms = time_ms([&]
+    {
+        for (size_t r = 0; r < repeats; r++)
+        {
+            for (const compressed_trajectory<double, 3>& trajectory : trajectories)
+            {
+                trajectory.decode(out.data());
+                checksum += out[r].x;
+            }
+        }
+    });
+    const double bytes = double(entities * ticks * sizeof(double3d));
+
+    std::printf("%-12s %10.0f KiB %8.1fx %10.1f ms %8.2f GB/s   (checksum %.3f)\n", name, double(compressed) / 1024, bytes / double(compressed), ms,
+                bytes * repeats / ms / 1e6, checksum);
+}
+
+int main()
+{
+    const std::vector<std::vector<double3d>> paths = record();
+
+    std::printf("%zu entities, %zu ticks; decoded GB/s of double3d\n\n", entities, ticks);
+    std::printf("%-12s %14s %9s %13s %13s\n", "", "size", "ratio", "decode", "");
+
+    bench_raw(paths);
+    bench_codec("exact", paths, 0, trajectory_predictor::delta);
+    bench_codec("1e-4 delta", paths, 1e-4, trajectory_predictor::delta);
+    bench_codec("1e-4 linear", paths, 1e-4, trajectory_predictor::linear);
+    bench_codec("1e-3 linear", paths, 1e-3, trajectory_predictor::linear);
+}
@@ -0,0 +1,72 @@
+// Compares a sparse volume stored as std::unordered_map<int3d, float> through dandy's std::hash
+// against the bricks of dandy/voxel.h: filling a spherical shell, summing its voxels, and reading the
+// six neighbours of each voxel.
+#include "common.h"
+#include <dandy/voxel.h>
+#include <unordered_map>
+
+constexpr int radius = 120;
+
+template<class Fn>
+void for_each_shell_voxel(const Fn& fn)
+{
+    for (int z = -radius; z <= radius; z++)
+    {
+        for (int y = -radius; y <= radius; y++)
+        {
+            for (int x = -radius; x <= radius; x++)
+            {
+                const int3d voxel(x, y, z);
+                const double distance = voxel.length();
+
+                if (distance >= radius - 2 && distance <= radius)
+                    fn(voxel, float(z + radius));
+            }
+        }
+    }
+}
+
+const int3d neighbours[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+int main()
+{
+    std::unordered_map<int3d, float> map;
+    voxel_grid<float> grid;
+    double times[2][3], sums[2][3] = {};
+
+    times[0][0] = time_ms([&] { for_each_shell_voxel([&](const int3d& v, const float value) { map[v] = value; }); });
+    times[1][0] = time_ms([&] { for_each_shell_voxel([&](const int3d& v, const float value) { grid.set(v, value); }); });
+
+    times[0][1] = time_ms([&] { for (const auto& [voxel, value] : map) sums[0][1] += value; });
+    times[1][1] = time_ms([&] { grid.for_each([&](const int3d&, const float value) { sums[1][1] += value; }); });
+
+    times[0][2] = time_ms([&]
+    {
+        for (const auto& [voxel, value] : map)
+        {
+            for (const int3d& offset : neighbours)
+            {
+                const auto it = map.find(voxel + offset);
+                sums[0][2] += it == map.end() ? 0.f : it->second;
+            }
+        }
+    });
+    times[1][2] = time_ms([&]
+    {
+        voxel_grid<float>::accessor accessor(grid);
+
+        grid.for_each([&](const int3d& voxel, float)
+        {
+            for (const int3d& offset : neighbours)
+                sums[1][2] += accessor.get(voxel + offset);
+        });
+    });
+
+    std::printf("%zu voxels in %zu bricks, ms\n\n", grid.size(), grid.brick_count());
+    std::printf("%-16s %12s %12s %12s\n", "", "insert", "iterate", "neighbours");
+
+    const char* names[2] = { "unordered_map", "voxel_grid" };
+
+    for (size_t i = 0; i < 2; i++)
+        std::printf("%-16s %12.1f %12.1f %12.1f   (checksums %.0f %.0f)\n", names[i], times[i][0], times[i][1], times[i][2], sums[i][1], sums[i][2]);
+}
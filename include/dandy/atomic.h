@@ -0,0 +1,198 @@
+#pragma once
+#include "dandy.h"
+#include <atomic>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief A vector whose components can be updated concurrently without locks
+/// @details Each component is an independent `std::atomic<Scalar>`: updates are atomic per
+///          component, not for the vector as a whole. Integer components are added to with the
+///          native `fetch_add`, floating point components with a compare-exchange loop.
+///
+/// @note Under heavy contention on few slots, `reduction_buffer` is usually faster
+/// @param Scalar The scalar type of the vector
+/// @param Size The size of the vector
+template<class Scalar, size_t Size>
+class atomic_vector
+{
+    static_assert(std::is_arithmetic_v<Scalar> && (Size > 1), "Invalid vector scalar_t or size");
+public:
+    /// @brief The non-atomic vector type the atomic vector holds
+    using vector_t = vector<Scalar, Size>;
+
+    /// @brief The scalar type of the vector
+    using scalar_t = Scalar;
+
+    /// @brief The vector size
+    static constexpr size_t size = Size;
+
+    /// @brief Whether all operations are lock-free on every platform
+    static constexpr bool is_always_lock_free = std::atomic<Scalar>::is_always_lock_free;
+
+    /// @brief Default constructs the vector
+    /// @details All components will be initialized to 0
+    atomic_vector() noexcept : atomic_vector(vector_t::zero) {}
+
+    /// @brief Initializes the components from a vector expression of the same size
+    template<class Expr, traits::require<traits::is_same_size_v<vector_t, Expr>> = 1>
+    atomic_vector(const Expr& expr) noexcept
+    {
+        for (size_t i = 0; i < Size; i++)
+            _data[i].store(static_cast<Scalar>(expr[i]), std::memory_order_relaxed);
+    }
+
+    atomic_vector(const atomic_vector&) = delete;
+    atomic_vector& operator=(const atomic_vector&) = delete;
+
+    /// @brief Atomically loads each component
+    vector_t load(const std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        vector_t out;
+
+        for (size_t i = 0; i < Size; i++)
+            out[i] = _data[i].load(order);
+        return out;
+    }
+
+    /// @brief Atomically stores each component of a vector expression
+    template<class Expr, traits::require<traits::is_same_size_v<vector_t, Expr>> = 1>
+    void store(const Expr& expr, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        for (size_t i = 0; i < Size; i++)
+            _data[i].store(static_cast<Scalar>(expr[i]), order);
+    }
+
+    /// @brief Atomically adds each component of a vector expression
+    /// @details The expression is evaluated once per component. Returns the previous components
+    template<class Expr, traits::require<traits::is_same_size_v<vector_t, Expr>> = 1>
+    vector_t fetch_add(const Expr& expr, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        vector_t out;
+
+        for (size_t i = 0; i < Size; i++)
+        {
+            const Scalar value = static_cast<Scalar>(expr[i]);
+
+            if constexpr(std::is_integral_v<Scalar> && !std::is_same_v<Scalar, bool>)
+                out[i] = _data[i].fetch_add(value, order);
+            else
+            {
+                Scalar expected = _data[i].load(std::memory_order_relaxed);
+
+                while (!_data[i].compare_exchange_weak(expected, static_cast<Scalar>(expected + value), order, std::memory_order_relaxed));
+                out[i] = expected;
+            }
+        }
+        return out;
+    }
+
+    /// @brief Atomically subtracts each component of a vector expression
+    /// @details Analogous to writing `fetch_add(-expr)`
+    template<class Expr, traits::require<traits::is_same_size_v<vector_t, Expr>> = 1>
+    vector_t fetch_sub(const Expr& expr, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return fetch_add(-expr, order);
+    }
+
+    /// @brief Atomically adds each component of a vector expression
+    template<class Expr, traits::require<traits::is_same_size_v<vector_t, Expr>> = 1>
+    atomic_vector& operator+=(const Expr& expr) noexcept
+    {
+        fetch_add(expr);
+        return *this;
+    }
+
+    /// @brief Atomically subtracts each component of a vector expression
+    template<class Expr, traits::require<traits::is_same_size_v<vector_t, Expr>> = 1>
+    atomic_vector& operator-=(const Expr& expr) noexcept
+    {
+        fetch_sub(expr);
+        return *this;
+    }
+
+    /// @brief Atomically loads each component
+    operator vector_t() const noexcept
+    {
+        return load();
+    }
+private:
+    std::atomic<Scalar> _data[Size];
+};
+
+/// @brief Per-thread accumulation buffers for a set of vector slots
+/// @details The alternative to `atomic_vector` for concurrent accumulation: each thread adds into
+///          its own copy of the slots without any synchronization, and the copies are summed
+///          afterwards by `reduce`. The copies of different threads never share a cache line.
+///          The reduction sums the threads in index order, so results are deterministic.
+/// @param Scalar The scalar type of the vectors
+/// @param Size The size of the vectors
+/// @param Allocator Allocator for the buffer storage
+template<class Scalar, size_t Size, class Allocator = std::allocator<vector<Scalar, Size>>>
+class reduction_buffer
+{
+public:
+    /// @brief The vector type of the slots
+    using vector_t = vector<Scalar, Size>;
+
+    /// @param slots The number of slots to accumulate into
+    /// @param threads The number of threads accumulating concurrently
+    reduction_buffer(const size_t slots, const size_t threads, const Allocator& allocator = Allocator())
+        : _slots(slots), _threads(threads), _stride(slots + (64 + sizeof(vector_t) - 1) / sizeof(vector_t)),
+          _data(_stride * threads, vector_t::zero, allocator) {}
+
+    /// @brief Gets the slots owned by a thread
+    /// @details Points to `slots()` vectors that only the thread `thread` may access until the
+    ///          next call to `reduce` or `clear`
+    vector_t* local(const size_t thread) noexcept
+    {
+        return _data.data() + thread * _stride;
+    }
+
+    /// @brief Adds the sum of all threads' copies of the slots in [first, last) to `out`
+    /// @details `out` points to the full range of `slots()` vectors. Disjoint ranges may be
+    ///          reduced concurrently
+    void reduce(vector_t* const out, const size_t first, const size_t last) const noexcept
+    {
+        for (size_t t = 0; t < _threads; t++)
+        {
+            const vector_t* const local = _data.data() + t * _stride;
+
+            for (size_t i = first; i < last; i++)
+                out[i] += local[i];
+        }
+    }
+
+    /// @brief Adds the sum of all threads' copies of the slots to `out`
+    void reduce(vector_t* const out) const noexcept
+    {
+        reduce(out, 0, _slots);
+    }
+
+    /// @brief Zeroes all threads' copies of the slots
+    void clear() noexcept
+    {
+        std::fill(_data.begin(), _data.end(), vector_t::zero);
+    }
+
+    /// @brief Gets the number of slots
+    size_t slots() const noexcept
+    {
+        return _slots;
+    }
+
+    /// @brief Gets the number of threads
+    size_t threads() const noexcept
+    {
+        return _threads;
+    }
+private:
+    size_t _slots;
+    size_t _threads;
+    size_t _stride;
+    std::vector<vector_t, Allocator> _data;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,241 @@
+#pragma once
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief An axis-aligned bounding box
+template<class Scalar, size_t Size>
+struct aabb
+{
+    using vector_t = vector<Scalar, Size>;
+
+    /// @brief Checks whether two boxes overlap, touching boxes included
+    bool overlaps(const aabb& other) const noexcept
+    {
+        return lo <= other.hi && other.lo <= hi;
+    }
+
+    /// @brief The minimum corner
+    vector_t lo;
+
+    /// @brief The maximum corner
+    vector_t hi;
+};
+
+/// @brief An incremental sweep-and-prune broadphase, finding the overlapping pairs among a set of boxes
+/// @details The boxes are kept sorted by their minimum on the sweep axis. Between frames the order is
+///          repaired by insertion sort, which takes about linear time when the boxes move little. Each
+///          box is then swept against the boxes whose minimum lies within its extent on the sweep axis,
+///          testing the remaining axes without branches over structure of arrays copies of the bounds.
+///
+///          The sweep axis should be the one along which the boxes are most spread out
+///
+/// @param Allocator Allocator for the internal arrays, rebound to the element types
+template<class Scalar, size_t Size, class Allocator = std::allocator<Scalar>>
+class sweep_and_prune
+{
+public:
+    using box_t = aabb<Scalar, Size>;
+    using pair_t = std::pair<uint32_t, uint32_t>;
+
+    /// @param axis The axis to sweep along, less than `Size`
+    explicit sweep_and_prune(const size_t axis = 0, const Allocator& allocator = Allocator())
+        : _axis(axis), _order(_index_allocator_t(allocator)),
+          _lo(_make_bounds(allocator, std::make_index_sequence<Size>())), _hi(_make_bounds(allocator, std::make_index_sequence<Size>())),
+          _chunk_pairs(_chunk_allocator_t(allocator))
+    {}
+
+    /// @brief Sets the boxes for the current frame
+    /// @details Box `i` is identified by index `i` in the pairs found. When the number of boxes is
+    ///          unchanged, the order of the last frame is repaired rather than sorted anew
+    /// @param count The number of boxes, at most 2^32 - 1
+    void update(const box_t* boxes, const size_t count)
+    {
+        if (count != _order.size())
+        {
+            _order.resize(count);
+
+            for (size_t i = 0; i < count; i++)
+                _order[i] = uint32_t(i);
+            std::sort(_order.begin(), _order.end(), [&](const uint32_t a, const uint32_t b) { return boxes[a].lo[_axis] < boxes[b].lo[_axis]; });
+
+            for (size_t c = 0; c < Size; c++)
+            {
+                _lo[c].resize(count);
+                _hi[c].resize(count);
+            }
+        }
+        else
+            _repair(boxes);
+
+        for (size_t k = 0; k < count; k++)
+        {
+            const box_t& box = boxes[_order[k]];
+
+            for (size_t c = 0; c < Size; c++)
+            {
+                _lo[c][k] = box.lo[c];
+                _hi[c][k] = box.hi[c];
+            }
+        }
+    }
+
+    /// @brief Finds the pairs of overlapping boxes
+    /// @details Each pair is reported once, as `(i, j)` with `i < j`, and appended to `out`. The order
+    ///          of the pairs does not depend on the number of threads
+    /// @param threads The number of threads generating pairs, 0 for `default_thread_count()`
+    void find_pairs(std::vector<pair_t>& out, const size_t threads = 1)
+    {
+        const size_t count = _order.size();
+        const size_t chunks = (count + _grain - 1) / _grain;
+
+        if (threads == 1 || chunks <= 1)
+        {
+            _sweep(0, count, out);
+            return;
+        }
+        while (_chunk_pairs.size() < chunks)
+            _chunk_pairs.emplace_back(_pair_allocator_t(_chunk_pairs.get_allocator()));
+
+        parallel_for(count, _grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            _pairs_t& pairs = _chunk_pairs[first / _grain];
+
+            pairs.clear();
+            _sweep(first, last, pairs);
+        });
+
+        size_t total = out.size();
+
+        for (size_t i = 0; i < chunks; i++)
+            total += _chunk_pairs[i].size();
+        out.reserve(total);
+
+        for (size_t i = 0; i < chunks; i++)
+            out.insert(out.end(), _chunk_pairs[i].begin(), _chunk_pairs[i].end());
+    }
+
+    /// @brief Gets the number of boxes
+    size_t size() const noexcept
+    {
+        return _order.size();
+    }
+
+    /// @brief Gets the sweep axis
+    size_t axis() const noexcept
+    {
+        return _axis;
+    }
+
+private:
+    using _index_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<uint32_t>;
+    using _scalar_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Scalar>;
+    using _bounds_t = std::vector<Scalar, _scalar_allocator_t>;
+    using _pair_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<pair_t>;
+    using _pairs_t = std::vector<pair_t, _pair_allocator_t>;
+    using _chunk_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<_pairs_t>;
+
+    // the number of boxes swept by a task when generating pairs on several threads
+    static constexpr size_t _grain = 1024;
+
+    // the number of candidates tested at once; the tests are stored before the pairs are collected
+    static constexpr size_t _block = 64;
+
+    template<size_t... Axes>
+    static std::array<_bounds_t, Size> _make_bounds(const Allocator& allocator, std::index_sequence<Axes...>)
+    {
+        return { ((void)Axes, _bounds_t(_scalar_allocator_t(allocator)))... };
+    }
+
+    // insertion sort of the previous order by the new minima, moving the sweep axis keys along
+    void _repair(const box_t* boxes)
+    {
+        _bounds_t& keys = _lo[_axis];
+
+        for (size_t k = 0; k < _order.size(); k++)
+            keys[k] = boxes[_order[k]].lo[_axis];
+
+        for (size_t k = 1; k < _order.size(); k++)
+        {
+            const Scalar key = keys[k];
+            const uint32_t index = _order[k];
+            size_t j = k;
+
+            for (; j > 0 && key < keys[j - 1]; j--)
+            {
+                keys[j] = keys[j - 1];
+                _order[j] = _order[j - 1];
+            }
+            keys[j] = key;
+            _order[j] = index;
+        }
+    }
+
+    // sweeps the boxes at the sorted positions [first, last) against all boxes after them
+    template<class Pairs>
+    void _sweep(const size_t first, const size_t last, Pairs& out) const
+    {
+        const Scalar* sweep_lo = _lo[_axis].data();
+        const size_t count = _order.size();
+
+        for (size_t i = first; i < last; i++)
+        {
+            // the candidates are the boxes starting before this one ends on the sweep axis
+            const size_t end = size_t(std::upper_bound(sweep_lo + i + 1, sweep_lo + count, _hi[_axis][i]) - sweep_lo);
+            Scalar lo[Size], hi[Size];
+
+            for (size_t c = 0; c < Size; c++)
+            {
+                lo[c] = _lo[c][i];
+                hi[c] = _hi[c][i];
+            }
+
+            for (size_t j = i + 1; j < end; j += _block)
+            {
+                const size_t block = std::min(_block, end - j);
+                // bytes rather than bools, which compilers do not vectorize loads of
+                unsigned char overlap[_block];
+
+                for (size_t b = 0; b < block; b++)
+                    overlap[b] = 1;
+
+                for (size_t c = 0; c < Size; c++)
+                {
+                    if (c == _axis)
+                        continue;
+                    const Scalar* other_lo = _lo[c].data() + j;
+                    const Scalar* other_hi = _hi[c].data() + j;
+
+                    for (size_t b = 0; b < block; b++)
+                        overlap[b] &= (other_lo[b] <= hi[c]) & (lo[c] <= other_hi[b]);
+                }
+
+                // most blocks hold no pair, which is checked without branching first
+                unsigned char any = 0;
+
+                for (size_t b = 0; b < block; b++)
+                    any |= overlap[b];
+
+                for (size_t b = 0; any && b < block; b++)
+                {
+                    if (overlap[b])
+                        out.emplace_back(std::minmax(_order[i], _order[j + b]));
+                }
+            }
+        }
+    }
+
+    size_t _axis;
+    std::vector<uint32_t, _index_allocator_t> _order;
+    std::array<_bounds_t, Size> _lo, _hi;
+    std::vector<_pairs_t, _chunk_allocator_t> _chunk_pairs; // the pairs of each chunk when sweeping on several threads
+};
+
+
+_DD_NAMESPACE_CLOSE
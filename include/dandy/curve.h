@@ -0,0 +1,388 @@
+#pragma once
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+namespace impl
+{
+    // the number of samples whose weights are computed together in batch evaluations
+    inline constexpr size_t _curve_block = 256;
+
+    // the number of samples claimed at once by a thread in batch evaluations
+    inline constexpr size_t _curve_grain = 4096;
+
+    // the cubic Bernstein polynomials, and their derivatives
+    template<class Scalar>
+    constexpr std::array<Scalar, 4> _bezier_weights(const Scalar t) noexcept
+    {
+        const Scalar s = 1 - t;
+        return { s * s * s, 3 * t * s * s, 3 * t * t * s, t * t * t };
+    }
+
+    template<class Scalar>
+    constexpr std::array<Scalar, 4> _bezier_derivative(const Scalar t) noexcept
+    {
+        const Scalar s = 1 - t;
+        return { -3 * s * s, 3 * s * (s - 2 * t), 3 * t * (2 * s - t), 3 * t * t };
+    }
+
+    // the rows of the uniform Catmull-Rom basis matrix applied to (u^3, u^2, u, 1)
+    template<class Scalar>
+    constexpr std::array<Scalar, 4> _catmull_rom_weights(const Scalar u) noexcept
+    {
+        const Scalar u2 = u * u, u3 = u2 * u;
+        return { Scalar(0.5) * (-u3 + 2 * u2 - u), Scalar(0.5) * (3 * u3 - 5 * u2 + 2), Scalar(0.5) * (-3 * u3 + 4 * u2 + u), Scalar(0.5) * (u3 - u2) };
+    }
+
+    template<class Scalar>
+    constexpr std::array<Scalar, 4> _catmull_rom_derivative(const Scalar u) noexcept
+    {
+        const Scalar u2 = u * u;
+        return { Scalar(0.5) * (-3 * u2 + 4 * u - 1), Scalar(0.5) * (9 * u2 - 10 * u), Scalar(0.5) * (-9 * u2 + 8 * u + 1), Scalar(0.5) * (3 * u2 - 2 * u) };
+    }
+
+    // the weighted sum of four control points, as a single expression evaluated once per component
+    template<class Scalar, size_t Size>
+    constexpr vector<Scalar, Size> _combine(const vector<Scalar, Size>& p0, const vector<Scalar, Size>& p1, const vector<Scalar, Size>& p2,
+                                            const vector<Scalar, Size>& p3, const std::array<Scalar, 4>& w) noexcept
+    {
+        return vector<Scalar, Size>(p0 * w[0] + p1 * w[1] + p2 * w[2] + p3 * w[3]);
+    }
+}
+
+/// @brief A cubic Bézier curve, over the parameter range [0, 1]
+/// @details Evaluated in Bernstein form: the four weights are computed once per parameter and the
+///          point as one expression of the control points, without intermediate vectors
+template<class Scalar, size_t Size>
+struct cubic_bezier
+{
+    using vector_t = vector<Scalar, Size>;
+
+    static_assert(std::is_floating_point_v<Scalar>, "Curves have to be of a floating point type");
+
+    /// @brief The control points: the curve starts at the first towards the second, and ends at the
+    ///        last coming from the third
+    std::array<vector_t, 4> points;
+
+    /// @brief Gets the point at a parameter
+    constexpr vector_t operator()(const Scalar t) const noexcept
+    {
+        return impl::_combine(points[0], points[1], points[2], points[3], impl::_bezier_weights(t));
+    }
+
+    /// @brief Gets the derivative with respect to the parameter
+    constexpr vector_t derivative(const Scalar t) const noexcept
+    {
+        return impl::_combine(points[0], points[1], points[2], points[3], impl::_bezier_derivative(t));
+    }
+
+    /// @brief Gets the end of the parameter range, 1
+    constexpr Scalar domain() const noexcept
+    {
+        return 1;
+    }
+
+    /// @brief Evaluates the points at an array of parameters
+    /// @details The weights of a block of samples are computed together and then applied, both loops
+    ///          compiling to vector instructions across the samples
+    /// @param threads The number of threads, 0 for `default_thread_count()`
+    void evaluate(const Scalar* t, const size_t count, vector_t* out, const size_t threads = 1) const
+    {
+        parallel_for(count, impl::_curve_grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            // a local copy, which the stores to `out` cannot alias
+            const std::array<vector_t, 4> p = points;
+            Scalar weights[4][impl::_curve_block];
+
+            for (size_t block = first; block < last; block += impl::_curve_block)
+            {
+                const size_t width = std::min(impl::_curve_block, last - block);
+
+                for (size_t i = 0; i < width; i++)
+                {
+                    const std::array<Scalar, 4> w = impl::_bezier_weights(t[block + i]);
+
+                    for (size_t k = 0; k < 4; k++)
+                        weights[k][i] = w[k];
+                }
+                for (size_t i = 0; i < width; i++)
+                {
+                    for (size_t c = 0; c < Size; c++)
+                        out[block + i][c] = weights[0][i] * p[0][c] + weights[1][i] * p[1][c] + weights[2][i] * p[2][c] + weights[3][i] * p[3][c];
+                }
+            }
+        });
+    }
+
+    /// @brief Splits the curve at a parameter with de Casteljau's algorithm
+    /// @return The curves over [0, t] and [t, 1], each reparameterized over [0, 1]
+    constexpr std::array<cubic_bezier, 2> split(const Scalar t) const noexcept
+    {
+        const vector_t a(points[0].lerp(points[1], t)), b(points[1].lerp(points[2], t)), c(points[2].lerp(points[3], t));
+        const vector_t ab(a.lerp(b, t)), bc(b.lerp(c, t));
+        const vector_t middle(ab.lerp(bc, t));
+
+        return { cubic_bezier{ { points[0], a, ab, middle } }, cubic_bezier{ { middle, bc, c, points[3] } } };
+    }
+};
+
+/// @brief A uniform Catmull-Rom spline through an array of points
+/// @details Segment `i` runs from point `i` to point `i + 1` over the parameters [i, i + 1], with
+///          tangents from the neighbouring points; the first and last points are repeated to give
+///          the end segments their tangents. Evaluated in basis matrix form: the four weights are
+///          computed once per parameter and the point as one expression of the control points.
+///          A spline of a single point stays at it, and an empty spline at zero
+/// @param Allocator Allocator for the control points
+template<class Scalar, size_t Size, class Allocator = std::allocator<vector<Scalar, Size>>>
+class catmull_rom_spline
+{
+public:
+    using vector_t = vector<Scalar, Size>;
+
+    static_assert(std::is_floating_point_v<Scalar>, "Curves have to be of a floating point type");
+
+    explicit catmull_rom_spline(const Allocator& allocator = Allocator()) : _padded(allocator) {}
+
+    /// @param points The points the spline passes through
+    catmull_rom_spline(const vector_t* points, const size_t count, const Allocator& allocator = Allocator())
+        : _padded(allocator)
+    {
+        if (count == 0)
+            return;
+
+        _padded.reserve(count + 2);
+        _padded.push_back(points[0]);
+        _padded.insert(_padded.end(), points, points + count);
+        _padded.push_back(points[count - 1]);
+    }
+
+    /// @brief Gets the point at a parameter, clamped to [0, `domain()`]
+    vector_t operator()(const Scalar t) const noexcept
+    {
+        if (size() < 2)
+            return _constant();
+
+        const auto [p, u] = _segment(t);
+        return impl::_combine(p[0], p[1], p[2], p[3], impl::_catmull_rom_weights(u));
+    }
+
+    /// @brief Gets the derivative with respect to the parameter, clamped to [0, `domain()`]
+    vector_t derivative(const Scalar t) const noexcept
+    {
+        if (size() < 2)
+            return vector_t::zero;
+
+        const auto [p, u] = _segment(t);
+        return impl::_combine(p[0], p[1], p[2], p[3], impl::_catmull_rom_derivative(u));
+    }
+
+    /// @brief Gets the end of the parameter range: the number of segments
+    Scalar domain() const noexcept
+    {
+        return Scalar(segment_count());
+    }
+
+    /// @brief Gets the number of segments, one less than the number of points
+    size_t segment_count() const noexcept
+    {
+        return size() < 2 ? 0 : size() - 1;
+    }
+
+    /// @brief Evaluates the points at an array of parameters
+    /// @details The segments and weights of a block of samples are computed together, then the points
+    ///          component by component. Both loops run across the samples; the first compiles to
+    ///          vector instructions, the second gathers the control points of each sample
+    /// @param threads The number of threads, 0 for `default_thread_count()`
+    void evaluate(const Scalar* t, const size_t count, vector_t* out, const size_t threads = 1) const
+    {
+        if (size() < 2)
+        {
+            std::fill_n(out, count, _constant());
+            return;
+        }
+
+        const Scalar end = domain();
+        const uint32_t last_segment = uint32_t(segment_count() - 1);
+
+        parallel_for(count, impl::_curve_grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            Scalar weights[4][impl::_curve_block];
+            uint32_t segments[impl::_curve_block];
+
+            for (size_t block = first; block < last; block += impl::_curve_block)
+            {
+                const size_t width = std::min(impl::_curve_block, last - block);
+
+                for (size_t i = 0; i < width; i++)
+                {
+                    const Scalar clamped = std::min(std::max(t[block + i], Scalar(0)), end);
+                    const uint32_t segment = std::min(uint32_t(clamped), last_segment);
+                    const std::array<Scalar, 4> w = impl::_catmull_rom_weights(clamped - Scalar(segment));
+
+                    segments[i] = segment;
+
+                    for (size_t k = 0; k < 4; k++)
+                        weights[k][i] = w[k];
+                }
+                for (size_t i = 0; i < width; i++)
+                {
+                    const vector_t* p = &_padded[segments[i]];
+
+                    for (size_t c = 0; c < Size; c++)
+                        out[block + i][c] = weights[0][i] * p[0][c] + weights[1][i] * p[1][c] + weights[2][i] * p[2][c] + weights[3][i] * p[3][c];
+                }
+            }
+        });
+    }
+
+    /// @brief Appends a point, adding a segment
+    void push_back(const vector_t& point)
+    {
+        // the repeated last point becomes the new point, which is then repeated
+        if (_padded.empty())
+            _padded.push_back(point);
+        else
+            _padded.back() = point;
+
+        _padded.push_back(point);
+        if (_padded.size() == 2)
+            _padded.push_back(point);
+    }
+
+    /// @brief Gets the control points
+    const vector_t* points() const noexcept
+    {
+        return _padded.empty() ? nullptr : _padded.data() + 1;
+    }
+
+    /// @brief Gets the number of control points
+    size_t size() const noexcept
+    {
+        return _padded.empty() ? 0 : _padded.size() - 2;
+    }
+
+private:
+    struct _location
+    {
+        const vector_t* points; // the four control points of the segment
+        Scalar u;
+    };
+
+    // the point of a spline without segments
+    vector_t _constant() const noexcept
+    {
+        return _padded.empty() ? vector_t::zero : _padded[0];
+    }
+
+    // requires at least 2 points
+    _location _segment(const Scalar t) const noexcept
+    {
+        const Scalar clamped = std::min(std::max(t, Scalar(0)), domain());
+        const size_t segment = std::min(size_t(clamped), segment_count() - 1);
+
+        return { &_padded[segment], clamped - Scalar(segment) };
+    }
+
+    // the control points with the first and last repeated, so that segments need no clamping
+    std::vector<vector_t, Allocator> _padded;
+};
+
+/// @brief A table of the arc length of a curve, mapping distances along it to parameters
+/// @details Samples the curve at evenly spaced parameters and accumulates the distances between
+///          consecutive samples. Distances are then mapped to parameters by interpolating the table,
+///          e.g. to move along the curve at constant speed, which parameters do not in general
+/// @param Allocator Allocator for the table
+template<class Scalar, class Allocator = std::allocator<Scalar>>
+class arc_length_table
+{
+public:
+    static_assert(std::is_floating_point_v<Scalar>, "Arc lengths have to be of a floating point type");
+
+    /// @brief Builds the table of a curve, e.g. a `cubic_bezier` or a `catmull_rom_spline`
+    /// @param samples The number of intervals of the table; more give more accurate lengths
+    template<class Curve>
+    arc_length_table(const Curve& curve, const size_t samples = 256, const Allocator& allocator = Allocator())
+        : _domain(curve.domain()), _lengths(allocator)
+    {
+        const size_t intervals = std::max<size_t>(samples, 1);
+        std::vector<typename Curve::vector_t> points(intervals + 1);
+        std::vector<Scalar> parameters(intervals + 1);
+
+        for (size_t k = 0; k <= intervals; k++)
+            parameters[k] = _domain * Scalar(k) / Scalar(intervals);
+        curve.evaluate(parameters.data(), parameters.size(), points.data());
+
+        // accumulated in double precision, so that long tables of floats do not drift
+        double length = 0;
+
+        _lengths.resize(intervals + 1);
+        _lengths[0] = 0;
+
+        for (size_t k = 1; k <= intervals; k++)
+        {
+            length += points[k].distance(points[k - 1]);
+            _lengths[k] = Scalar(length);
+        }
+    }
+
+    /// @brief Gets the length of the curve
+    Scalar length() const noexcept
+    {
+        return _lengths.back();
+    }
+
+    /// @brief Gets the parameter at a distance along the curve, clamped to [0, `length()`]
+    Scalar parameter(const Scalar distance) const noexcept
+    {
+        const size_t k = std::upper_bound(_lengths.begin() + 1, _lengths.end() - 1, distance) - _lengths.begin() - 1;
+        return _interpolate(k, distance);
+    }
+
+    /// @brief Gets the parameters at distances along the curve, clamped to [0, `length()`]
+    /// @details Distances in increasing order are mapped by walking the table rather than searching it
+    void parameters(const Scalar* distances, Scalar* out, const size_t count) const noexcept
+    {
+        size_t k = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (i > 0 && distances[i] < distances[i - 1])
+                k = 0;
+            while (k + 2 < _lengths.size() && _lengths[k + 1] <= distances[i])
+                k++;
+            out[i] = _interpolate(k, distances[i]);
+        }
+    }
+
+    /// @brief Gets the parameters of `count` points evenly spaced along the curve, from its start to
+    ///        its end
+    void uniform_parameters(Scalar* out, const size_t count) const
+    {
+        std::vector<Scalar> distances(count);
+
+        for (size_t i = 0; i < count; i++)
+            distances[i] = count > 1 ? length() * Scalar(i) / Scalar(count - 1) : 0;
+        parameters(distances.data(), out, count);
+    }
+
+private:
+    // the parameter at a distance within interval k of the table
+    Scalar _interpolate(const size_t k, const Scalar distance) const noexcept
+    {
+        const Scalar span = _lengths[k + 1] - _lengths[k];
+        const Scalar fraction = span > 0 ? std::min(std::max((distance - _lengths[k]) / span, Scalar(0)), Scalar(1)) : Scalar(0);
+
+        return _domain * (Scalar(k) + fraction) / Scalar(_lengths.size() - 1);
+    }
+
+    Scalar _domain;
+    std::vector<Scalar, Allocator> _lengths;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -4,24 +4,32 @@
 #include <ostream>
 #include <type_traits>
 #include <tuple>      // std::tuple, std::apply
+#include <utility>    // std::pair
 #include <functional> // std::hash
 #include <algorithm>  // std::max
 #include <cstdint>    // fixed width integer types
+#include <cstring>    // std::memcpy
+#include <limits>     // std::numeric_limits
 #include <cmath>      // std::sqrt, std::sin, std::acos, std::atan2
 
+#ifdef DD_INSTRUMENT
+#include <atomic>
+#include <vector>
+#endif
+
 #define _DD_NAMESPACE_OPEN namespace dd {
 #define _DD_NAMESPACE_CLOSE }
-#define _DD_OPERATION_T auto
-#define _DD_DEFINE_BINARY_OPERATOR(op)                                                         \
+#define _DD_OPERATION_T decltype(auto)
+#ifdef DD_INSTRUMENT
+#define _DD_INSTRUMENT(kind, ...) (::dd::math::_is_constant_evaluated() ? void() : ::dd::instrument::_record<__VA_ARGS__>(::dd::instrument::event::kind))
+#else
+#define _DD_INSTRUMENT(kind, ...)
+#endif
+#define _DD_DEFINE_BINARY_OPERATOR(op, name)                                                   \
     template<class L, class R, traits::require<traits::is_valid_operation_v<L, R, false>> = 1> \
     inline constexpr _DD_OPERATION_T operator op (const L& l, const R& r)                      \
     {                                                                                          \
-        return impl::operation                                                                 \
-        {                                                                                      \
-            [](const auto& a, const auto& b) { return a op b; },                               \
-            l, r                                                                               \
-        };                                                                                     \
-                                                                                               \
+        return impl::_simplify(ops::name{}, l, r);                                             \
     }                                                                                          \
     template<class L, class R, traits::require<traits::is_valid_operation_v<L, R, true>> = 1>  \
     inline constexpr _DD_OPERATION_T operator op##=(L& l, const R& r)                          \
@@ -29,15 +37,85 @@
         return l = l op r;                                                                     \
     }
 
-#define _DD_DEFINE_UNARY_OPERATOR(op)                                        \
+#define _DD_DEFINE_UNARY_OPERATOR(op, name)                                  \
     template<class Expr, traits::require<traits::is_expression_v<Expr>> = 1> \
     inline constexpr _DD_OPERATION_T operator op (const Expr& expr)          \
     {                                                                        \
-        return impl::operation                                               \
-        {                                                                    \
-            [](const auto& v) { return op(v); },                             \
-            expr                                                             \
-        };                                                                   \
+        return impl::_simplify(ops::name{}, expr);                           \
+    }
+
+#define _DD_DEFINE_BINARY_FUNCTOR(name, op)                     \
+    struct name                                                 \
+    {                                                           \
+        static constexpr std::string_view _name = #name;        \
+                                                                \
+        template<class A, class B>                              \
+        constexpr auto operator()(const A& a, const B& b) const \
+        {                                                       \
+            return a op b;                                      \
+        }                                                       \
+    }
+
+#define _DD_DEFINE_UNARY_FUNCTOR(name, op)               \
+    struct name                                          \
+    {                                                    \
+        static constexpr std::string_view _name = #name; \
+                                                         \
+        template<class A>                                \
+        constexpr auto operator()(const A& a) const      \
+        {                                                \
+            return op(a);                                \
+        }                                                \
+    }
+
+#define _DD_DEFINE_REAL_FUNCTOR(name, fn)                \
+    struct name                                          \
+    {                                                    \
+        static constexpr std::string_view _name = #name; \
+                                                         \
+        template<class A>                                \
+        constexpr auto operator()(const A& a) const      \
+        {                                                \
+            return fn(static_cast<math::real_t<A>>(a));  \
+        }                                                \
+    }
+
+#define _DD_DEFINE_SWIZZLE(name, ...)                  \
+    constexpr _DD_OPERATION_T name() const noexcept    \
+    {                                                  \
+        return _child().template swizzle<__VA_ARGS__>(); \
+    }                                                  \
+    constexpr _DD_OPERATION_T name() noexcept          \
+    {                                                  \
+        return _child().template swizzle<__VA_ARGS__>(); \
+    }
+
+#define _DD_SWIZZLE_INDEX_x 0
+#define _DD_SWIZZLE_INDEX_y 1
+#define _DD_SWIZZLE_INDEX_z 2
+#define _DD_SWIZZLE_INDEX_w 3
+
+#define _DD_DEFINE_SWIZZLE_2(a, b) \
+    _DD_DEFINE_SWIZZLE(a##b, _DD_SWIZZLE_INDEX_##a, _DD_SWIZZLE_INDEX_##b)
+
+#define _DD_DEFINE_SWIZZLE_3(a, b, c) \
+    _DD_DEFINE_SWIZZLE(a##b##c, _DD_SWIZZLE_INDEX_##a, _DD_SWIZZLE_INDEX_##b, _DD_SWIZZLE_INDEX_##c)
+
+#define _DD_DEFINE_SWIZZLES_2(a) \
+    _DD_DEFINE_SWIZZLE_2(a, x) _DD_DEFINE_SWIZZLE_2(a, y) _DD_DEFINE_SWIZZLE_2(a, z) _DD_DEFINE_SWIZZLE_2(a, w)
+
+#define _DD_DEFINE_SWIZZLES_3(a, b) \
+    _DD_DEFINE_SWIZZLE_3(a, b, x) _DD_DEFINE_SWIZZLE_3(a, b, y) _DD_DEFINE_SWIZZLE_3(a, b, z) _DD_DEFINE_SWIZZLE_3(a, b, w)
+
+#define _DD_DEFINE_SWIZZLES(a) \
+    _DD_DEFINE_SWIZZLES_2(a)   \
+    _DD_DEFINE_SWIZZLES_3(a, x) _DD_DEFINE_SWIZZLES_3(a, y) _DD_DEFINE_SWIZZLES_3(a, z) _DD_DEFINE_SWIZZLES_3(a, w)
+
+#define _DD_DEFINE_BINARY_FUNCTION(name)                                                       \
+    template<class L, class R, traits::require<traits::is_valid_operation_v<L, R, false>> = 1> \
+    inline constexpr _DD_OPERATION_T name(const L& l, const R& r)                              \
+    {                                                                                          \
+        return impl::operation{ ops::name{}, l, r };                                           \
     }
 
 
@@ -55,8 +133,20 @@ namespace impl
     template<class, class...>
     struct operation;
 
-    template<class, size_t>
+    template<class, size_t...>
+    struct view;
+
+    template<class, size_t, bool = false>
     struct value;
+
+    namespace ops
+    {
+        struct exp;
+        struct sin;
+        struct cos;
+        struct clamp;
+        struct lerp;
+    }
 }
 
 /// @brief Interface to convert between a dandy vector type and an arbitrary foreign type
@@ -69,6 +159,16 @@ namespace impl
 template<class Dandy, class Foreign>
 struct converter;
 
+/// @brief An integral scalar whose value is known at compile time
+/// @details Operations with constants are simplified when the expression is built, e.g.
+///          `v * constant<1>()` is `v` itself and `-(-v)` is `v`. Can be used wherever a scalar
+///          operand can be used
+/// @param Value The value of the constant
+template<auto Value>
+struct constant : std::integral_constant<decltype(Value), Value> {};
+
+/// @details The `_t` and `_v` shorthands refer to the implementations directly, which keeps the
+///          number of class template instantiations per expression type down
 namespace traits
 {
     /// @brief Helper metafunction to return a template type unchanged
@@ -88,14 +188,14 @@ namespace traits
     template<class T>
     struct _is_value : std::false_type {};
 
-    template<class Scalar, size_t Size>
-    struct _is_value<impl::value<Scalar, Size>> : std::true_type {};
+    template<class Scalar, size_t Size, bool Aligned>
+    struct _is_value<impl::value<Scalar, Size, Aligned>> : std::true_type {};
     
     template<class T>
     struct is_value : _is_value<T> {};
 
     template<class T>
-    inline constexpr bool is_value_v = is_value<T>::value;
+    inline constexpr bool is_value_v = _is_value<T>::value;
     
     /// @struct is_operation
     /// @brief Determines if a type is a vector operation
@@ -109,19 +209,68 @@ namespace traits
     struct is_operation : _is_operation<T> {};
 
     template<class T>
-    inline constexpr bool is_operation_v = is_operation<T>::value;
+    inline constexpr bool is_operation_v = _is_operation<T>::value;
+
+    /// @struct is_view
+    /// @brief Determines if a type is a vector view, i.e. a swizzle or slice
+    template<class T>
+    struct _is_view : std::false_type {};
+
+    template<class Expr, size_t... Indices>
+    struct _is_view<impl::view<Expr, Indices...>> : std::true_type {};
+
+    template<class T>
+    struct is_view : _is_view<T> {};
+
+    template<class T>
+    inline constexpr bool is_view_v = _is_view<T>::value;
+
+    /// @struct is_constant
+    /// @brief Determines if a type is a compile-time `constant`
+    template<class T>
+    struct _is_constant : std::false_type {};
+
+    template<auto Value>
+    struct _is_constant<constant<Value>> : std::true_type {};
+
+    template<class T>
+    struct is_constant : _is_constant<T> {};
+
+    template<class T>
+    inline constexpr bool is_constant_v = _is_constant<T>::value;
+
+    /// @struct is_scalar
+    /// @brief Determines if a type can be a scalar operand of a vector operation
+    /// @details Returns true iff a type is arithmetic or a `constant`
+    template<class T>
+    struct _is_scalar : std::bool_constant<std::is_arithmetic_v<T> || _is_constant<T>::value> {};
+
+    template<class T>
+    struct is_scalar : _is_scalar<T> {};
+
+    template<class T>
+    inline constexpr bool is_scalar_v = _is_scalar<T>::value;
 
     /// @struct is_expression
     /// @brief Determines if a type is a vector expression
-    /// @details Returns true iff a type is a value or an operation
+    /// @details Returns true iff a type is a value, an operation or a view
     template<class T>
-    struct _is_expression : std::disjunction<is_value<T>, is_operation<T>> {};
+    struct _is_expression : std::false_type {};
+
+    template<class Scalar, size_t Size, bool Aligned>
+    struct _is_expression<impl::value<Scalar, Size, Aligned>> : std::true_type {};
+
+    template<class Op_fn, class... Operands>
+    struct _is_expression<impl::operation<Op_fn, Operands...>> : std::true_type {};
+
+    template<class Expr, size_t... Indices>
+    struct _is_expression<impl::view<Expr, Indices...>> : std::true_type {};
 
     template<class T>
     struct is_expression : _is_expression<T> {};
 
     template<class T>
-    inline constexpr bool is_expression_v = is_expression<T>::value;
+    inline constexpr bool is_expression_v = _is_expression<T>::value;
 
     /// @struct scalar
     /// @brief Gets the scalar type of a vector expression
@@ -132,10 +281,17 @@ namespace traits
     struct _scalar_impl : type_identity<Scalar> {};
 
     template<class Op_fn, class... Operands>
-    struct _scalar_impl<impl::operation<Op_fn, Operands...>> : std::invoke_result<Op_fn, typename _scalar_impl<Operands>::type...> {};
+    struct _scalar_impl<impl::operation<Op_fn, Operands...>>
+        : type_identity<decltype(std::declval<const Op_fn&>()(std::declval<typename _scalar_impl<Operands>::type>()...))> {};
 
-    template<class Scalar, size_t Size>
-    struct _scalar_impl<impl::value<Scalar, Size>> : type_identity<Scalar> {};
+    template<class Scalar, size_t Size, bool Aligned>
+    struct _scalar_impl<impl::value<Scalar, Size, Aligned>> : type_identity<Scalar> {};
+
+    template<auto Value>
+    struct _scalar_impl<constant<Value>> : type_identity<decltype(Value)> {};
+
+    template<class Expr, size_t... Indices>
+    struct _scalar_impl<impl::view<Expr, Indices...>> : _scalar_impl<std::remove_const_t<Expr>> {};
 
     template<class Expr, require<is_expression_v<Expr>> = 1>
     struct _scalar : _scalar_impl<Expr> {};
@@ -144,7 +300,7 @@ namespace traits
     struct scalar : _scalar<Expr> {};
 
     template<class Expr>
-    using scalar_t = typename scalar<Expr>::type;
+    using scalar_t = typename _scalar<Expr>::type;
 
     /// @struct size
     /// @brief Gets the size of a vector expression
@@ -157,8 +313,11 @@ namespace traits
     template<class Op_fn, class... Operands>
     struct _size_impl<impl::operation<Op_fn, Operands...>> : std::integral_constant<size_t, std::max({ _size_impl<Operands>::value... })> {};
 
-    template<class Scalar, size_t Size>
-    struct _size_impl<impl::value<Scalar, Size>> : std::integral_constant<size_t, Size> {};
+    template<class Scalar, size_t Size, bool Aligned>
+    struct _size_impl<impl::value<Scalar, Size, Aligned>> : std::integral_constant<size_t, Size> {};
+
+    template<class Expr, size_t... Indices>
+    struct _size_impl<impl::view<Expr, Indices...>> : std::integral_constant<size_t, sizeof...(Indices)> {};
 
     template<class Expr, require<is_expression_v<Expr>> = 1>
     struct _size : _size_impl<Expr> {};
@@ -167,7 +326,34 @@ namespace traits
     struct size : _size<Expr> {};
 
     template<class Expr>
-    inline constexpr size_t size_v = size<Expr>::value;
+    inline constexpr size_t size_v = _size<Expr>::value;
+
+    /// @struct capacity
+    /// @brief Gets the number of components that can be read from a vector expression
+    /// @details 
+    ///  - *Values*: returns the number of stored components, including padding
+    ///  - *Operations*: returns the smallest capacity of its operands
+    ///  - *Views*: returns the size of the view
+    template<class>
+    struct _capacity_impl : std::integral_constant<size_t, SIZE_MAX> {};
+
+    template<class Op_fn, class... Operands>
+    struct _capacity_impl<impl::operation<Op_fn, Operands...>> : std::integral_constant<size_t, std::min({ _capacity_impl<Operands>::value... })> {};
+
+    template<class Scalar, size_t Size, bool Aligned>
+    struct _capacity_impl<impl::value<Scalar, Size, Aligned>> : std::integral_constant<size_t, impl::value<Scalar, Size, Aligned>::capacity> {};
+
+    template<class Expr, size_t... Indices>
+    struct _capacity_impl<impl::view<Expr, Indices...>> : std::integral_constant<size_t, sizeof...(Indices)> {};
+
+    template<class Expr, require<is_expression_v<Expr>> = 1>
+    struct _capacity : _capacity_impl<Expr> {};
+
+    template<class Expr>
+    struct capacity : _capacity<Expr> {};
+
+    template<class Expr>
+    inline constexpr size_t capacity_v = _capacity<Expr>::value;
     
     /// @struct vector
     /// @brief Gets the resulting vector type of a vector expression
@@ -179,7 +365,7 @@ namespace traits
     struct vector : _vector<Expr> {};
 
     template<class Expr>
-    using vector_t = typename vector<Expr>::type;
+    using vector_t = typename _vector<Expr>::type;
 
     /// @struct is_same_size
     /// @brief Determines if two types are vector expressions of the same size
@@ -193,7 +379,7 @@ namespace traits
     struct is_same_size : _is_same_size<T, U, is_expression_v<T> && is_expression_v<U>> {};
 
     template<class T, class U>
-    inline constexpr bool is_same_size_v = is_same_size<T, U>::value;
+    inline constexpr bool is_same_size_v = _is_same_size<T, U, is_expression_v<T> && is_expression_v<U>>::value;
 
     /// @struct is_valid_operation
     /// @brief Determines if two types form a valid vector operation
@@ -202,14 +388,14 @@ namespace traits
     template<class L, class R, bool Strict_ordering>
     struct _is_valid_operation
         : std::bool_constant<(is_same_size_v<L, R>)                                               ||
-                             (is_expression_v<L> && std::is_arithmetic_v<R>)                      ||
-                             (std::is_arithmetic_v<L> && is_expression_v<R> && !Strict_ordering)> {};
+                             (is_expression_v<L> && is_scalar_v<R>)                               ||
+                             (is_scalar_v<L> && is_expression_v<R> && !Strict_ordering)> {};
     
     template<class L, class R, bool Strict_ordering>
     struct is_valid_operation : _is_valid_operation<L, R, Strict_ordering> {};
 
     template<class L, class R, bool Strict_ordering>
-    inline constexpr bool is_valid_operation_v = is_valid_operation<L, R, Strict_ordering>::value;
+    inline constexpr bool is_valid_operation_v = _is_valid_operation<L, R, Strict_ordering>::value;
 
     /// @struct has_converter
     /// @brief Determines if there is a converter specilization defined between two types
@@ -226,25 +412,1145 @@ namespace traits
     struct has_converter : _has_converter<T, U> {};
 
     template<class T, class U>
-    inline constexpr bool has_converter_v = has_converter<T, U>::value;
+    inline constexpr bool has_converter_v = _has_converter<T, U>::value;
+
+    /// @brief Estimated cost of evaluating one component of a vector expression
+    struct expression_cost
+    {
+        /// @brief Arithmetic, bitwise and comparison operations
+        size_t ops = 0;
+
+        /// @brief Components read from vector values
+        size_t loads = 0;
+
+        /// @brief Calls to transcendental functions, i.e. `exp`, `sin` and `cos`
+        size_t transcendentals = 0;
+
+        constexpr expression_cost operator+(const expression_cost& other) const noexcept
+        {
+            return { ops + other.ops, loads + other.loads, transcendentals + other.transcendentals };
+        }
+    };
+
+    /// @struct cost
+    /// @brief Estimates the cost of evaluating one component of a vector expression
+    /// @details 
+    ///  - *Values*: returns one load
+    ///  - *Operations*: returns the cost of the operands plus that of the applied function. Functions
+    ///    other than the built-in operators and functions count as one op
+    ///  - *Views*: returns the cost of the referred expression
+    ///
+    ///  Scalar operands are free, as they are held in registers
+    template<class Op_fn>
+    struct _op_cost
+    {
+        static constexpr expression_cost value = { 1, 0, 0 };
+    };
+
+    template<>
+    struct _op_cost<impl::ops::exp>
+    {
+        static constexpr expression_cost value = { 0, 0, 1 };
+    };
+
+    template<>
+    struct _op_cost<impl::ops::sin> : _op_cost<impl::ops::exp> {};
+
+    template<>
+    struct _op_cost<impl::ops::cos> : _op_cost<impl::ops::exp> {};
+
+    template<>
+    struct _op_cost<impl::ops::clamp>
+    {
+        static constexpr expression_cost value = { 2, 0, 0 };
+    };
+
+    template<>
+    struct _op_cost<impl::ops::lerp>
+    {
+        static constexpr expression_cost value = { 4, 0, 0 };
+    };
+
+    template<class>
+    struct _cost_impl
+    {
+        static constexpr expression_cost value = {};
+    };
+
+    template<class Op_fn, class... Operands>
+    struct _cost_impl<impl::operation<Op_fn, Operands...>>
+    {
+        static constexpr expression_cost value = (_op_cost<Op_fn>::value + ... + _cost_impl<Operands>::value);
+    };
+
+    template<class Scalar, size_t Size, bool Aligned>
+    struct _cost_impl<impl::value<Scalar, Size, Aligned>>
+    {
+        static constexpr expression_cost value = { 0, 1, 0 };
+    };
+
+    template<class Expr, size_t... Indices>
+    struct _cost_impl<impl::view<Expr, Indices...>> : _cost_impl<std::remove_const_t<Expr>> {};
+
+    template<class Expr, require<is_expression_v<Expr>> = 1>
+    struct _cost : _cost_impl<Expr> {};
+
+    template<class Expr>
+    struct cost : _cost<Expr> {};
+
+    template<class Expr>
+    inline constexpr expression_cost cost_v = _cost<Expr>::value;
+}
+
+/// @brief Branch-free implementations of elementary functions
+/// @details Unlike their `<cmath>` counterparts these neither call into libm nor branch on
+///          their input, so loops applying them over arrays (and the vector operations built
+///          on them) can be auto-vectorized by the compiler. They are implemented for `float`
+///          and `double`; other floating point types fall back to `<cmath>`.
+namespace math
+{
+    /// @brief The floating point type used for the result of transcendental functions
+    /// @details Floating point types are kept as they are, integers are promoted to `double`
+    template<class T>
+    using real_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    /// @brief Tag selecting full precision implementations
+    struct precise_t {};
+
+    /// @brief Tag selecting low-degree approximations with bounded error
+    struct fast_t {};
+
+    inline constexpr precise_t precise{};
+    inline constexpr fast_t fast{};
+
+    /// @brief Determines if a type is one of the precision tags
+    template<class T>
+    inline constexpr bool is_policy_v = std::is_same_v<T, precise_t> || std::is_same_v<T, fast_t>;
+
+    /// @brief Determines if the call is part of a constant evaluation
+    /// @details The functions below switch to `constexpr` implementations during constant evaluation
+    ///          and call into `<cmath>` otherwise, so their run time code is unaffected
+    constexpr bool _is_constant_evaluated() noexcept
+    {
+#ifdef __cpp_lib_is_constant_evaluated
+        return std::is_constant_evaluated();
+#else
+        return __builtin_is_constant_evaluated();
+#endif
+    }
+
+    template<class T>
+    inline constexpr bool _has_kernel_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    template<class T>
+    constexpr T _abs(const T x) noexcept
+    {
+        if (_is_constant_evaluated())
+            return x < T(0) ? -x : x + T(0); // the addition turns -0 into +0
+        return std::abs(x);
+    }
+
+    template<class T>
+    constexpr T _floor(const T x) noexcept
+    {
+        if (_is_constant_evaluated())
+        {
+            if (!(_abs(x) < T(4503599627370496.0))) // 2^52: larger values are integral, NaN is kept
+                return x;
+
+            const T truncated = static_cast<T>(static_cast<std::int64_t>(x));
+            return truncated > x ? truncated - T(1) : truncated;
+        }
+#ifndef __FAST_MATH__
+        if constexpr(_has_kernel_v<T>)
+        {
+            // rounds by adding and subtracting 2^52 (2^23 for `float`), which unlike `std::floor` is
+            // vectorized without -fno-trapping-math. Larger values are integral, NaN is kept
+            constexpr T magic = T(1) / std::numeric_limits<T>::epsilon();
+
+            const T offset = x < T(0) ? -magic : magic;
+            const T rounded = (x + offset) - offset;
+
+            // written with `min` so that the correction is not turned back into a branch
+            const T floored = std::min(rounded, (rounded - T(1)) + T(rounded <= x));
+
+            // the floor has the sign of `x`; copied so that -0 is not turned into +0 by the rounding
+            return _abs(x) < magic ? std::copysign(floored, x) : x;
+        }
+#endif
+        return std::floor(x);
+    }
+
+    /// @brief Whether `sqrt(s)` lies above the midpoint of its neighbouring candidates `a < b`
+    /// @details For `s` in [1, 4) and `a`, `b` in [1, 2] one ULP apart. The squares are split into
+    ///          exact pairs with Dekker's product, so the sign of `4 * s - (a + b)^2` is exact
+    template<class T>
+    constexpr bool _above_midpoint(const T s, const T a, const T b) noexcept
+    {
+        constexpr T split = T(std::uint64_t(1) << (std::numeric_limits<T>::digits + 1) / 2) + T(1);
+
+        const auto square_error = [&](const T y, const T product)
+        {
+            const T high = split * y - (split * y - y);
+            const T low = y - high;
+            return ((high * high - product) + T(2) * high * low) + low * low;
+        };
+        const T a2 = a * a, b2 = b * b;
+
+        // 4 * s - (a + b)^2 = 2 * (s - a^2) + 2 * (s - b^2) + (b - a)^2, whose last term is half
+        // a unit of the rest and only decides between equal sums
+        return ((s - a2) + (s - b2)) - (square_error(a, a2) + square_error(b, b2)) >= T(0);
+    }
+
+    /// @brief Computes the square root of `x`
+    /// @details `std::sqrt`, or Newton's method corrected to the same correctly rounded result
+    ///          during constant evaluation
+    template<class T>
+    constexpr T sqrt(const T x) noexcept
+    {
+        if (_is_constant_evaluated())
+        {
+            constexpr T infinity = std::numeric_limits<T>::infinity();
+
+            if (!(x > T(0)) || x == infinity)
+                return x == T(0) || x == infinity ? x : std::numeric_limits<T>::quiet_NaN();
+
+            // scaled by even powers of 2 into [1, 4), whose root in [1, 2) has a fixed ULP
+            T s = x, scale = T(1);
+
+            for (; s >= T(4); scale *= T(2))
+                s *= T(0.25);
+            for (; s < T(1); scale *= T(0.5))
+                s *= T(4);
+
+            // starting above the root, the iterations decrease until they converge
+            T out = s;
+
+            while (true)
+            {
+                const T next = T(0.5) * (out + s / out);
+
+                if (!(next < out))
+                    break;
+                out = next;
+            }
+
+            // the converged iterate may be a neighbour of the correctly rounded root
+            constexpr T ulp = std::numeric_limits<T>::epsilon();
+
+            while (out > T(1) && !_above_midpoint(s, out - ulp, out))
+                out -= ulp;
+            while (out < T(2) && _above_midpoint(s, out, out + ulp))
+                out += ulp;
+            return out * scale;
+        }
+        return std::sqrt(x);
+    }
+
+    /// @brief Computes the arc tangent of `x` during constant evaluation
+    /// @details Evaluated in `long double` by halving the angle until a Taylor series converges quickly
+    constexpr long double _atan(const long double x) noexcept
+    {
+        constexpr long double half_pi = 1.57079632679489661923132169163975144L;
+
+        if (x != x)
+            return x;
+        if (x > 1.0L || x < -1.0L)
+            return (x > 0.0L ? half_pi : -half_pi) - _atan(1.0L / x);
+
+        long double t = x;
+        long double scale = 1.0L;
+
+        while (t > 0.125L || t < -0.125L)
+        {
+            // atan(t) = 2 * atan(t / (1 + sqrt(1 + t^2)))
+            t = t / (1.0L + sqrt(1.0L + t * t));
+            scale *= 2.0L;
+        }
+
+        const long double t2 = t * t;
+        long double term = t;
+        long double sum = t;
+
+        for (long double n = 3.0L; ; n += 2.0L)
+        {
+            term *= -t2;
+            const long double next = sum + term / n;
+
+            if (next == sum)
+                return scale * sum;
+            sum = next;
+        }
+    }
+
+    /// @brief Determines if the sign bit of `x` is set, for constant evaluation where `std::signbit`
+    ///        is not `constexpr`
+    constexpr bool _signbit(const long double x) noexcept
+    {
+        // through `double`, which keeps the sign and has no padding bits
+        return __builtin_bit_cast(std::uint64_t, static_cast<double>(x)) >> 63;
+    }
+
+    /// @brief Computes the angle of the point `(x, y)` during constant evaluation
+    /// @details Signed zeros and infinities give the results of `std::atan2`
+    constexpr long double _atan2(const long double y, const long double x) noexcept
+    {
+        constexpr long double pi = 3.14159265358979323846264338327950288L;
+        constexpr long double infinity = std::numeric_limits<long double>::infinity();
+
+        if (x != x || y != y)
+            return x + y;
+
+        // the angle of `(x, |y|)`, mirrored by the sign of `y` last
+        const bool x_negative = _signbit(x), y_negative = _signbit(y);
+        const long double ax = x_negative ? -x : x, ay = y_negative ? -y : y;
+        long double angle = 0.0L;
+
+        if (ay == infinity)
+            angle = ax == infinity ? (x_negative ? pi * 0.75L : pi * 0.25L) : pi / 2.0L;
+        else if (ax == infinity)
+            angle = x_negative ? pi : 0.0L;
+        else if (ax == 0.0L)
+            angle = ay == 0.0L ? (x_negative ? pi : 0.0L) : pi / 2.0L;
+        else
+            angle = x_negative ? pi - _atan(ay / ax) : _atan(ay / ax);
+        return y_negative ? -angle : angle;
+    }
+
+    template<class T>
+    struct _float_info;
+
+    template<>
+    struct _float_info<float>
+    {
+        using bits_t = std::int32_t;
+        static constexpr int mantissa = 23;
+        static constexpr int bias = 127;
+    };
+
+    template<>
+    struct _float_info<double>
+    {
+        using bits_t = std::int64_t;
+        static constexpr int mantissa = 52;
+        static constexpr int bias = 1023;
+    };
+
+    /// @brief Computes `2^n` for an integral valued `n` within the normal exponent range
+    template<class T>
+    inline T _pow2(const T n) noexcept
+    {
+        using info = _float_info<T>;
+        using bits_t = typename info::bits_t;
+
+        const bits_t bits = (static_cast<bits_t>(n) + info::bias) << info::mantissa;
+        T out;
+        std::memcpy(&out, &bits, sizeof(T));
+        return out;
+    }
+
+    /// @brief Tests the sign bit of `x`, like `std::signbit` but vectorized for `double`
+    template<class T>
+    inline bool _sign_bit(const T x) noexcept
+    {
+        using bits_t = typename _float_info<T>::bits_t;
+
+        bits_t bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        return (bits >> (sizeof(T) * 8 - 1)) != 0;
+    }
+
+    /// @brief Chooses `a` if `c`, else `b`, by masking their bits
+    /// @details Both values are computed beforehand. A select between floating point values may be
+    ///          compiled to a branch around the computation of the chosen one, which keeps loops
+    ///          applying the function from being vectorized unless traps are disabled
+    template<class T>
+    inline T _select(const bool c, const T a, const T b) noexcept
+    {
+        using bits_t = typename _float_info<T>::bits_t;
+
+        bits_t a_bits, b_bits;
+        std::memcpy(&a_bits, &a, sizeof(T));
+        std::memcpy(&b_bits, &b, sizeof(T));
+
+        const bits_t mask = -static_cast<bits_t>(c);
+        const bits_t bits = (a_bits & mask) | (b_bits & ~mask);
+        T out;
+        std::memcpy(&out, &bits, sizeof(T));
+        return out;
+    }
+
+    /// @brief Computes `e^x`
+    /// @details Cody-Waite range reduction followed by a polynomial (`float`) or Padé
+    ///          (`double`) approximation. Maximum error over the full domain: 1 ULP
+    ///          (`float`) and 2 ULP (`double`). Results below the smallest subnormal are
+    ///          flushed to zero, results above the largest finite value are infinite
+    template<class T>
+    inline T exp(const T x) noexcept
+    {
+        if constexpr(!_has_kernel_v<T>)
+            return std::exp(x);
+        else
+        {
+            constexpr bool single = std::is_same_v<T, float>;
+            constexpr T log2e  = T(1.44269504088896340736);
+            constexpr T ln2_hi = single ? T(0.693359375)     : T(6.93145751953125E-1);
+            constexpr T ln2_lo = single ? T(-2.12194440e-4)  : T(1.42860682030941723212E-6);
+            constexpr T max    = single ? T(88.72283905206835) : T(709.782712893384);
+            constexpr T min    = single ? T(-103.972077083992) : T(-745.1332191019411);
+
+            // NaN is replaced before the reduction so that `n` stays within the exponent range
+            // `_pow2` can represent; the NaN itself is returned below
+            const T clamped = _select(x != x, T(0), std::min(std::max(x, min), max));
+            const T n = std::floor(clamped * log2e + T(0.5));
+            const T r = (clamped - n * ln2_hi) - n * ln2_lo;
+            const T rr = r * r;
+            T y;
+
+            if constexpr(single)
+            {
+                y = (((((T(1.9875691500E-4)  * r +
+                         T(1.3981999507E-3)) * r +
+                         T(8.3334519073E-3)) * r +
+                         T(4.1665795894E-2)) * r +
+                         T(1.6666665459E-1)) * r +
+                         T(5.0000001201E-1)) * rr + r + T(1);
+            }
+            else
+            {
+                const T p = r * ((T(1.26177193074810590878E-4) * rr +
+                                  T(3.02994407707441961300E-2)) * rr +
+                                  T(9.99999999999999999910E-1));
+                const T q = ((T(3.00198505138664455042E-6)  * rr +
+                              T(2.52448340349684104192E-3)) * rr +
+                              T(2.27265548208155028766E-1)) * rr +
+                              T(2.00000000000000000009E0);
+                y = T(1) + T(2) * p / (q - p);
+            }
+            // scale in two steps so that both overflowing and subnormal results are reached
+            const T half = std::floor(n * T(0.5));
+            y = y * _pow2(half) * _pow2(n - half);
+
+            if (x != x)
+                return x;
+            return x > max ? std::numeric_limits<T>::infinity() : (x < min ? T(0) : y);
+        }
+    }
+
+    /// @brief Computes the sine and cosine of `x` in a single pass
+    /// @details Cody-Waite reduction to an octant followed by one polynomial for each
+    ///          function. Maximum error: 2 ULP for |x| < 2^30 (`float` and `double`).
+    ///          Precision degrades gradually outside of this range
+    template<class T>
+    constexpr void sincos(const T x, T& sin, T& cos) noexcept
+    {
+        if constexpr(!_has_kernel_v<T>)
+        {
+            sin = std::sin(x);
+            cos = std::cos(x);
+        }
+        else
+        {
+            constexpr bool single = std::is_same_v<T, float>;
+            constexpr double four_over_pi = 1.27323954473516268615;
+            constexpr double dp1 = 7.85398125648498535156E-1;
+            constexpr double dp2 = 3.77489470793079817668E-8;
+            constexpr double dp3 = 2.69515142907905952645E-15;
+
+            // the reduction is always carried out in double precision, this keeps `float`
+            // results accurate close to the zeroes of the functions
+            const double ax = _abs(static_cast<double>(x));
+
+            // octant index rounded up to be even; `j` is one of 0, 2, 4, 6
+            double y = _floor(ax * four_over_pi);
+            y += y - 2.0 * _floor(y * 0.5);
+            const double j = y - 8.0 * _floor(y * 0.125);
+
+            const T r = static_cast<T>(((ax - y * dp1) - y * dp2) - y * dp3);
+            const T z = r * r;
+            T s = 0, c = 0;
+
+            if constexpr(single)
+            {
+                s = ((T(-1.9515295891E-4) * z + T(8.3321608736E-3)) * z + T(-1.6666654611E-1)) * z * r + r;
+                c = ((T(2.443315711809948E-5) * z + T(-1.388731625493765E-3)) * z + T(4.166664568298827E-2)) * z * z - T(0.5) * z + T(1);
+            }
+            else
+            {
+                s = r + r * z * (((((T(1.58962301576546568060E-10)  * z +
+                                     T(-2.50507477628578072866E-8)) * z +
+                                     T(2.75573136213857245213E-6))  * z +
+                                     T(-1.98412698295895385996E-4)) * z +
+                                     T(8.33333333332211858878E-3))  * z +
+                                     T(-1.66666666666666307295E-1));
+                c = T(1) - T(0.5) * z + z * z * (((((T(-1.13585365213876817300E-11) * z +
+                                                     T(2.08757008419747316778E-9))   * z +
+                                                     T(-2.75573141792967388112E-7))  * z +
+                                                     T(2.48015872888517045348E-5))   * z +
+                                                     T(-1.38888888888730564116E-3))  * z +
+                                                     T(4.16666666666665929218E-2));
+            }
+            // negations rather than multiplications by the signs, which would be compiled to
+            // branches where the loops applying this cannot be vectorized
+            const bool swap = j == 2.0 || j == 6.0;
+            const T sin_abs = swap ? c : s, cos_abs = swap ? s : c;
+
+            sin = (j >= 4.0) != (x < T(0)) ? -sin_abs : sin_abs;
+            cos = j == 2.0 || j == 4.0 ? -cos_abs : cos_abs;
+        }
+    }
+
+    /// @brief Computes the sine of `x`
+    /// @details See `sincos` for error bounds
+    template<class T>
+    constexpr T sin(const T x) noexcept
+    {
+        T s = 0, c = 0;
+        sincos(x, s, c);
+        return s;
+    }
+
+    /// @brief Computes the cosine of `x`
+    /// @details See `sincos` for error bounds
+    template<class T>
+    constexpr T cos(const T x) noexcept
+    {
+        T s = 0, c = 0;
+        sincos(x, s, c);
+        return c;
+    }
+
+    /// @brief Computes `e^x` for each element of an array
+    template<class T>
+    inline void exp(const T* in, T* out, const size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; i++)
+            out[i] = exp(in[i]);
+    }
+
+    /// @brief Computes the sine and cosine of each element of an array
+    template<class T>
+    inline void sincos(const T* in, T* sin, T* cos, const size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; i++)
+            sincos(in[i], sin[i], cos[i]);
+    }
+
+    /// @brief Computes the sine and cosine of `x` in a single pass using low-degree polynomials
+    /// @details The reduction is carried out in the precision of `T` and the polynomials are
+    ///          the ones of the single precision kernel. Maximum absolute error: 1e-7 for
+    ///          |x| < 8192
+    template<class T>
+    constexpr void sincos(const T x, T& sin, T& cos, fast_t) noexcept
+    {
+        if constexpr(!_has_kernel_v<T>)
+            sincos(x, sin, cos);
+        else
+        {
+            constexpr T four_over_pi = T(1.27323954473516268615);
+            constexpr T dp1 = T(0.78515625);
+            constexpr T dp2 = T(2.4187564849853515625e-4);
+            constexpr T dp3 = T(3.77489497744594108e-8);
+
+            const T ax = _abs(x);
+
+            // see the precise kernel for the octant reduction
+            T y = _floor(ax * four_over_pi);
+            y += y - T(2) * _floor(y * T(0.5));
+            const T j = y - T(8) * _floor(y * T(0.125));
+
+            const T r = ((ax - y * dp1) - y * dp2) - y * dp3;
+            const T z = r * r;
+            const T s = ((T(-1.9515295891E-4) * z + T(8.3321608736E-3)) * z + T(-1.6666654611E-1)) * z * r + r;
+            const T c = ((T(2.443315711809948E-5) * z + T(-1.388731625493765E-3)) * z + T(4.166664568298827E-2)) * z * z - T(0.5) * z + T(1);
+
+            const bool swap = j == T(2) || j == T(6);
+            const T sin_abs = swap ? c : s, cos_abs = swap ? s : c;
+
+            sin = (j >= T(4)) != (x < T(0)) ? -sin_abs : sin_abs;
+            cos = j == T(2) || j == T(4) ? -cos_abs : cos_abs;
+        }
+    }
+
+    /// @brief Computes the sine and cosine of `x` in a single pass
+    /// @details Overload to allow dispatching on a precision tag
+    template<class T>
+    constexpr void sincos(const T x, T& sin, T& cos, precise_t) noexcept
+    {
+        sincos(x, sin, cos);
+    }
+
+    /// @brief Computes the angle of the point `(x, y)`
+    /// @details The ratio of the smaller to the larger coordinate is reduced to [0, 0.66] and
+    ///          approximated by the rational function of Cephes, then unfolded with selects rather
+    ///          than branches. `float` is computed in `double` and rounded once. Maximum error,
+    ///          measured against a `long double` reference: 1 ULP (`float`) and 2 ULP (`double`),
+    ///          where `std::atan2` is within 1 ULP. Signed zeros, infinities and NaN give the
+    ///          results of `std::atan2`. Used by the array kernels; `atan2(y, x, precise)` calls
+    ///          `std::atan2`
+    template<class T>
+    constexpr T atan2(const T y, const T x) noexcept
+    {
+        if (_is_constant_evaluated())
+            return static_cast<T>(_atan2(y, x));
+
+        if constexpr(!_has_kernel_v<T>)
+            return std::atan2(y, x);
+        else if constexpr(std::is_same_v<T, float>)
+            return static_cast<float>(atan2(static_cast<double>(y), static_cast<double>(x)));
+        else
+        {
+            constexpr long double pi_ld = 3.14159265358979323846264338327950288L;
+
+            // the constants and their rounding errors, added back last
+            constexpr T pi = T(pi_ld), pi_lo = T(pi_ld - pi);
+            constexpr T half_pi = T(pi_ld / 2), half_pi_lo = T(pi_ld / 2 - half_pi);
+            constexpr T quarter_pi = T(pi_ld / 4), quarter_pi_lo = T(pi_ld / 4 - quarter_pi);
+
+            // the reductions are computed whether they apply or not, then chosen with `_select`
+            const T ax = _abs(x), ay = _abs(y);
+            const T hi = std::max(ax, ay), lo = std::min(ax, ay);
+            const T t = lo / hi; // NaN for 0 / 0 and infinity / infinity, whose results are set last
+
+            const bool reduce = t > T(0.66);
+            const T u = _select(reduce, (t - T(1)) / (t + T(1)), t);
+            const T z = u * u;
+
+            const T p = (((T(-8.750608600031904122785E-1) * z +
+                           T(-1.615753718733365076637E1)) * z +
+                           T(-7.500855792314704667340E1)) * z +
+                           T(-1.228866684490136173410E2)) * z +
+                           T(-6.485021904942025371773E1);
+            const T q = ((((z +
+                            T(2.485846490142306297962E1)) * z +
+                            T(1.650270098316988542046E2)) * z +
+                            T(4.328810604912902668951E2)) * z +
+                            T(4.853903996359136964868E2)) * z +
+                            T(1.945506571482613964425E2);
+            T r = u * (z * p / q) + u;
+
+            // unfolding, with the rounding errors of the constants added back last
+            const bool complement = ay > ax, supplement = _sign_bit(x);
+
+            r = _select(reduce, quarter_pi + (r + quarter_pi_lo), r);
+            r = _select(complement, (half_pi - r) + half_pi_lo, r);
+            r = _select(supplement, (pi - r) + pi_lo, r);
+
+            // the corners where `t` is NaN, and NaN, which `std::min` and `std::max` may have dropped
+            T corner = _select(hi == T(0), T(0), quarter_pi);
+            corner = _select(supplement, pi - corner, corner);
+
+            r = _select(t != t, corner, r);
+            r = _select(x != x || y != y, x + y, r);
+            return _sign_bit(y) ? -r : r;
+        }
+    }
+
+    /// @brief Computes the angle of the point `(x, y)` using a polynomial approximation
+    /// @details Maximum absolute error: 2e-6 radians. `atan2(0, 0)` is 0
+    template<class T>
+    constexpr T atan2(const T y, const T x, fast_t) noexcept
+    {
+        constexpr T pi = T(3.14159265358979323846);
+
+        // see the precise kernel for the selects
+        const T ax = _abs(x);
+        const T ay = _abs(y);
+        const T hi = std::max(ax, ay);
+        const T t = std::min(ax, ay) / std::max(hi, std::numeric_limits<T>::denorm_min());
+        const T s = t * t;
+
+        T r = t * (((((T(-0.01172120)  * s +
+                       T(0.05265332))  * s +
+                       T(-0.11643287)) * s +
+                       T(0.19354346))  * s +
+                       T(-0.33262347)) * s +
+                       T(0.99997726));
+
+        r = (ay > ax ? pi / 2 : T(0)) + (ay > ax ? -r : r);
+        r = (x < T(0) ? pi : T(0)) + (x < T(0) ? -r : r);
+        return y < T(0) ? -r : r;
+    }
+
+    /// @brief Computes the angle of the point `(x, y)`
+    /// @details Overload to allow dispatching on a precision tag
+    template<class T>
+    constexpr T atan2(const T y, const T x, precise_t) noexcept
+    {
+        if (_is_constant_evaluated())
+            return static_cast<T>(_atan2(y, x));
+        return std::atan2(y, x);
+    }
+
+    /// @brief Computes the arc cosine of `x` using a polynomial approximation
+    /// @details Abramowitz & Stegun 4.4.46. Maximum absolute error: 3e-8 radians (`double`)
+    ///          and 5e-7 radians (`float`). The input is clamped to [-1, 1]
+    template<class T>
+    constexpr T acos(const T x, fast_t) noexcept
+    {
+        constexpr T pi = T(3.14159265358979323846);
+
+        const T ax = std::min(_abs(x), T(1));
+        const T r = sqrt(T(1) - ax) * (((((((T(-0.0012624911)  * ax +
+                                                  T(0.0066700901))  * ax +
+                                                  T(-0.0170881256)) * ax +
+                                                  T(0.0308918810))  * ax +
+                                                  T(-0.0501743046)) * ax +
+                                                  T(0.0889789874))  * ax +
+                                                  T(-0.2145988016)) * ax +
+                                                  T(1.5707963050));
+        return x < T(0) ? pi - r : r;
+    }
+
+    /// @brief Computes the arc cosine of `x`
+    /// @details Overload to allow dispatching on a precision tag. The input is clamped to [-1, 1]
+    template<class T>
+    constexpr T acos(const T x, precise_t) noexcept
+    {
+        const T clamped = std::max(std::min(x, T(1)), T(-1));
+
+        if (_is_constant_evaluated())
+        {
+            const long double c = clamped;
+            return static_cast<T>(_atan2(sqrt((1.0L - c) * (1.0L + c)), c));
+        }
+        return std::acos(clamped);
+    }
 }
 
+#ifdef DD_INSTRUMENT
+/// @brief Counters of the work done by vector expressions
+/// @details Only exists when `DD_INSTRUMENT` is defined before including dandy, which has to be done
+///          consistently across all translation units. Otherwise the hooks compile to nothing
+namespace instrument
+{
+    /// @brief The kinds of recorded events
+    enum class event
+    {
+        evaluation,      ///< A component of an operation was evaluated, including the padding
+                         ///< components evaluated alongside when assigning to an aligned value
+        materialization, ///< An operation or view was evaluated into a vector value; copies
+                         ///< between vector values are not counted
+        conversion,      ///< A converter was invoked, to or from a foreign type
+        hash             ///< A vector value was hashed
+    };
+
+    /// @brief The events recorded for one expression type
+    struct counters
+    {
+        std::string_view type;
+        size_t evaluations = 0;
+        size_t materializations = 0;
+        size_t conversions = 0;
+        size_t hashes = 0;
+    };
+
+    /// @brief Function called for every recorded event, by the thread the event occurred in
+    using callback_t = void(*)(event kind, std::string_view type);
+
+    /// @brief Gets the name of a type as spelled by the compiler, e.g. `dd::impl::value<float, 3, false>`
+    template<class T>
+    constexpr std::string_view type_name() noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        const std::string_view name = __FUNCSIG__;
+        const size_t first = name.find("type_name<") + 10;
+        const size_t last = name.rfind(">(void)");
+#else
+        const std::string_view name = __PRETTY_FUNCTION__;
+        const size_t first = name.find("T = ") + 4;
+        const size_t last = std::min(name.find(';', first), name.rfind(']'));
+#endif
+        return name.substr(first, last - first);
+    }
+
+    struct _entry
+    {
+        std::string_view type;
+        std::atomic<size_t> counts[4];
+        _entry* next;
+    };
+
+    inline std::atomic<_entry*> _entries = nullptr;
+    inline std::atomic<callback_t> _callback = nullptr;
+
+    /// @brief Gets the entry of a type, registering it on first use
+    template<class T>
+    inline _entry& _entry_of() noexcept
+    {
+        static _entry entry = { type_name<T>(), {}, nullptr };
+        static const bool registered = [] {
+            entry.next = _entries.load(std::memory_order_relaxed);
+            while (!_entries.compare_exchange_weak(entry.next, &entry));
+            return true;
+        }();
+
+        (void)registered;
+        return entry;
+    }
+
+    template<class T>
+    inline void _record(const event kind) noexcept
+    {
+        _entry& entry = _entry_of<T>();
+        entry.counts[static_cast<size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+
+        if (const callback_t callback = _callback.load(std::memory_order_relaxed))
+            callback(kind, entry.type);
+    }
+
+    inline counters _read(const _entry& entry) noexcept
+    {
+        counters out;
+
+        out.type = entry.type;
+        out.evaluations = entry.counts[0].load(std::memory_order_relaxed);
+        out.materializations = entry.counts[1].load(std::memory_order_relaxed);
+        out.conversions = entry.counts[2].load(std::memory_order_relaxed);
+        out.hashes = entry.counts[3].load(std::memory_order_relaxed);
+        return out;
+    }
+
+    /// @brief Sets the function called for every event, or `nullptr` to only count them
+    inline void set_callback(const callback_t callback) noexcept
+    {
+        _callback.store(callback);
+    }
+
+    /// @brief Gets the events recorded for an expression type since the last reset
+    template<class T>
+    inline counters get() noexcept
+    {
+        return _read(_entry_of<T>());
+    }
+
+    /// @brief Gets the events recorded for every expression type since the last reset
+    /// @details Types without events are left out
+    inline std::vector<counters> snapshot()
+    {
+        std::vector<counters> out;
+
+        for (const _entry* entry = _entries.load(); entry; entry = entry->next)
+        {
+            const counters c = _read(*entry);
+
+            if (c.evaluations || c.materializations || c.conversions || c.hashes)
+                out.push_back(c);
+        }
+        return out;
+    }
+
+    /// @brief Zeroes all counters
+    inline void reset() noexcept
+    {
+        for (_entry* entry = _entries.load(); entry; entry = entry->next)
+        {
+            for (std::atomic<size_t>& count : entry->counts)
+                count.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+#endif
+
 namespace impl
 {
-    _DD_DEFINE_BINARY_OPERATOR(+);
-    _DD_DEFINE_BINARY_OPERATOR(-);
-    _DD_DEFINE_BINARY_OPERATOR(*);
-    _DD_DEFINE_BINARY_OPERATOR(/);
-    _DD_DEFINE_BINARY_OPERATOR(%);
-    _DD_DEFINE_BINARY_OPERATOR(&);
-    _DD_DEFINE_BINARY_OPERATOR(|);
-    _DD_DEFINE_BINARY_OPERATOR(^);
-    _DD_DEFINE_BINARY_OPERATOR(>>);
-    _DD_DEFINE_BINARY_OPERATOR(<<);
-
-    _DD_DEFINE_UNARY_OPERATOR(+);
-    _DD_DEFINE_UNARY_OPERATOR(-);
-    _DD_DEFINE_UNARY_OPERATOR(~);
+    /// @brief Function objects applied by the operators
+    /// @details Named rather than lambdas so that simplifications can recognize the kind of an operation
+    namespace ops
+    {
+        _DD_DEFINE_BINARY_FUNCTOR(plus, +);
+        _DD_DEFINE_BINARY_FUNCTOR(minus, -);
+        _DD_DEFINE_BINARY_FUNCTOR(multiplies, *);
+        _DD_DEFINE_BINARY_FUNCTOR(divides, /);
+        _DD_DEFINE_BINARY_FUNCTOR(modulus, %);
+        _DD_DEFINE_BINARY_FUNCTOR(bit_and, &);
+        _DD_DEFINE_BINARY_FUNCTOR(bit_or, |);
+        _DD_DEFINE_BINARY_FUNCTOR(bit_xor, ^);
+        _DD_DEFINE_BINARY_FUNCTOR(shift_right, >>);
+        _DD_DEFINE_BINARY_FUNCTOR(shift_left, <<);
+
+        _DD_DEFINE_UNARY_FUNCTOR(unary_plus, +);
+        _DD_DEFINE_UNARY_FUNCTOR(negate, -);
+        _DD_DEFINE_UNARY_FUNCTOR(bit_not, ~);
+
+        _DD_DEFINE_UNARY_FUNCTOR(abs, std::abs);
+        _DD_DEFINE_UNARY_FUNCTOR(round, std::round);
+        _DD_DEFINE_UNARY_FUNCTOR(floor, std::floor);
+        _DD_DEFINE_UNARY_FUNCTOR(ceil, std::ceil);
+        _DD_DEFINE_REAL_FUNCTOR(sqrt, math::sqrt);
+        _DD_DEFINE_REAL_FUNCTOR(exp, math::exp);
+        _DD_DEFINE_REAL_FUNCTOR(sin, math::sin);
+        _DD_DEFINE_REAL_FUNCTOR(cos, math::cos);
+
+        /// @brief Compares two scalars by value, also when one is signed and the other unsigned
+        template<class A, class B>
+        constexpr bool _less(const A a, const B b) noexcept
+        {
+            using common_t = std::common_type_t<A, B>;
+
+            if constexpr (std::is_integral_v<common_t> && std::is_signed_v<A> != std::is_signed_v<B>)
+            {
+                using unsigned_t = std::make_unsigned_t<common_t>;
+
+                if constexpr (std::is_signed_v<A>)
+                    return a < 0 || static_cast<unsigned_t>(a) < static_cast<unsigned_t>(b);
+                else
+                    return b >= 0 && static_cast<unsigned_t>(a) < static_cast<unsigned_t>(b);
+            }
+            else
+                return static_cast<common_t>(a) < static_cast<common_t>(b);
+        }
+
+        /// @brief The scalar type of `min`: the common type, made signed if either operand is
+        ///        signed, since the minimum never exceeds the signed operand
+        template<class A, class B, class Common = std::common_type_t<A, B>,
+            bool = std::is_integral_v<Common> && std::is_unsigned_v<Common> && (std::is_signed_v<A> || std::is_signed_v<B>)>
+        struct _min_scalar : traits::type_identity<Common> {};
+
+        template<class A, class B, class Common>
+        struct _min_scalar<A, B, Common, true> : std::make_signed<Common> {};
+
+        struct min
+        {
+            static constexpr std::string_view _name = "min";
+
+            template<class A, class B, class Result = typename _min_scalar<A, B>::type>
+            constexpr Result operator()(const A& a, const B& b) const
+            {
+                return _less(b, a) ? static_cast<Result>(b) : static_cast<Result>(a);
+            }
+        };
+
+        struct max
+        {
+            static constexpr std::string_view _name = "max";
+
+            /// @details The common type can represent the maximum: it is unsigned only if the
+            ///          unsigned operand is at least as wide, and the maximum is then non-negative
+            template<class A, class B, class Result = std::common_type_t<A, B>>
+            constexpr Result operator()(const A& a, const B& b) const
+            {
+                return _less(a, b) ? static_cast<Result>(b) : static_cast<Result>(a);
+            }
+        };
+
+        struct clamp
+        {
+            static constexpr std::string_view _name = "clamp";
+
+            template<class V, class L, class H, class Result = typename _min_scalar<std::common_type_t<V, L>, H>::type>
+            constexpr Result operator()(const V& v, const L& l, const H& h) const
+            {
+                if (_less(v, l))
+                    return static_cast<Result>(l);
+                return _less(h, v) ? static_cast<Result>(h) : static_cast<Result>(v);
+            }
+        };
+
+        struct lerp
+        {
+            static constexpr std::string_view _name = "lerp";
+
+            template<class A, class B, class F>
+            constexpr auto operator()(const A& a, const B& b, const F& f) const
+            {
+                return (1 - f) * a + f * b;
+            }
+        };
+
+        template<class Scalar>
+        struct cast
+        {
+            static constexpr std::string_view _name = "cast";
+
+            template<class A>
+            constexpr Scalar operator()(const A& a) const
+            {
+                return static_cast<Scalar>(a);
+            }
+        };
+    }
+
+    /// @brief Whether simplifications which may change floating point results by rounding are allowed
+    /// @details Enabled by defining `DD_FAST_MATH` before including dandy, consistently in all
+    ///          translation units
+#ifdef DD_FAST_MATH
+    inline constexpr bool _fast_math = true;
+#else
+    inline constexpr bool _fast_math = false;
+#endif
+
+    /// @brief Gets the scalar type of an operand; expressions and scalars alike
+    template<class T>
+    using _scalar_t = typename traits::_scalar_impl<T>::type;
+
+    /// @brief Determines if an operand is the constant `Value`
+    template<class T, int Value>
+    inline constexpr bool _is_constant_v = false;
+
+    template<auto Constant, int Value>
+    inline constexpr bool _is_constant_v<constant<Constant>, Value> = Constant == Value;
+
+    /// @brief Determines if an operand is the identity element of a binary operation
+    /// @param Right Whether the operand is the right-hand one
+    template<class Op_fn, class T, bool Right>
+    inline constexpr bool _is_identity_v =
+        (std::is_same_v<Op_fn, ops::multiplies>                         && _is_constant_v<T, 1>) ||
+        (std::is_same_v<Op_fn, ops::divides>                   && Right && _is_constant_v<T, 1>) ||
+        (std::is_same_v<Op_fn, ops::plus>                               && _is_constant_v<T, 0>) ||
+        (std::is_same_v<Op_fn, ops::minus>                     && Right && _is_constant_v<T, 0>) ||
+        (std::is_same_v<Op_fn, ops::bit_or>                             && _is_constant_v<T, 0>) ||
+        (std::is_same_v<Op_fn, ops::bit_xor>                            && _is_constant_v<T, 0>) ||
+        (std::is_same_v<Op_fn, ops::shift_left>                && Right && _is_constant_v<T, 0>) ||
+        (std::is_same_v<Op_fn, ops::shift_right>               && Right && _is_constant_v<T, 0>);
+
+    /// @brief Determines if an operand is an expression multiplied by a scalar
+    template<class T>
+    struct _is_scaled : std::false_type {};
+
+    template<class A, class B>
+    struct _is_scaled<operation<ops::multiplies, A, B>> : std::bool_constant<traits::is_scalar_v<A> != traits::is_scalar_v<B>>
+    {
+        /// @brief The index of the expression operand
+        static constexpr size_t expression = traits::is_scalar_v<A> ? 1 : 0;
+
+        /// @brief The type of the expression operand
+        using expression_t = std::conditional_t<traits::is_scalar_v<A>, B, A>;
+    };
+
+    /// @brief Determines if a unary operation undoes itself, i.e. `op(op(e))` is `e`
+    template<class Op_fn, class Expr>
+    struct _is_involution : std::false_type {};
+
+    template<class Op_fn, class Inner>
+    struct _is_involution<Op_fn, operation<Op_fn, Inner>>
+        : std::bool_constant<(std::is_same_v<Op_fn, ops::negate> || std::is_same_v<Op_fn, ops::bit_not>) &&
+                             std::is_same_v<_scalar_t<Inner>, _scalar_t<operation<Op_fn, operation<Op_fn, Inner>>>>> {};
+
+    /// @brief Computes the product of two scalars in the type `Scalar`
+    /// @details Integers are multiplied as unsigned, matching the wrap-around of the operation it replaces
+    template<class Scalar, class A, class B>
+    inline constexpr Scalar _product(const A& a, const B& b) noexcept
+    {
+        if constexpr(std::is_integral_v<Scalar>)
+        {
+            using unsigned_t = std::common_type_t<std::make_unsigned_t<Scalar>, unsigned>;
+            return static_cast<Scalar>(static_cast<unsigned_t>(static_cast<Scalar>(a)) * static_cast<unsigned_t>(static_cast<Scalar>(b)));
+        }
+        else
+            return static_cast<Scalar>(a) * static_cast<Scalar>(b);
+    }
+
+    /// @brief Merges the scalar factors of `(e * s1) * s2` into `e * (s1 * s2)`
+    template<class Scaled, class S>
+    inline constexpr _DD_OPERATION_T _merge_factors(const Scaled& scaled, const S& s) noexcept
+    {
+        constexpr size_t index = _is_scaled<Scaled>::expression;
+        using scalar_t = _scalar_t<Scaled>;
+
+        return operation
+        {
+            ops::multiplies{},
+            scaled.template operand<index>(),
+            _product<scalar_t>(scaled.template operand<1 - index>(), s)
+        };
+    }
+
+    /// @brief Determines if the factors of `(e * s1) * s2` can be merged without changing the result
+    template<class Scaled, class S>
+    inline constexpr bool _can_merge_factors() noexcept
+    {
+        if constexpr(!_is_scaled<Scaled>::value || !traits::is_scalar_v<S>)
+            return false;
+        else
+        {
+            using expression_t = typename _is_scaled<Scaled>::expression_t;
+            using scalar_t = _scalar_t<Scaled>;
+
+            return std::is_same_v<_scalar_t<operation<ops::multiplies, Scaled, S>>, scalar_t>             &&
+                   std::is_same_v<_scalar_t<operation<ops::multiplies, expression_t, scalar_t>>, scalar_t> &&
+                   !std::is_same_v<scalar_t, bool> && (std::is_integral_v<scalar_t> || _fast_math);
+        }
+    }
+
+    /// @brief Creates a binary operation, simplifying it where the result is unaffected
+    /// @details Applied when the operation is created, so the expression tree reaching an assignment
+    ///          is already simplified:
+    ///           - `e * 1`, `1 * e`, `e / 1`, `e + 0`, `0 + e`, `e - 0` and the bitwise identities are
+    ///             `e` itself, when one operand is a `constant` and the scalar type is unchanged
+    ///           - `(e * s1) * s2` and its permutations are `e * (s1 * s2)`
+    ///           - `e / s` is `e * (1 / s)`
+    ///
+    ///          The last two, and `e + 0`, change floating point results by rounding (or the sign of
+    ///          zero) and are only applied to floating point operations with `DD_FAST_MATH`
+    template<class Op_fn, class L, class R>
+    inline constexpr _DD_OPERATION_T _simplify(const Op_fn op, const L& l, const R& r) noexcept
+    {
+        using scalar_t = _scalar_t<operation<Op_fn, L, R>>;
+        constexpr bool exact = std::is_integral_v<scalar_t> || _fast_math || !std::is_same_v<Op_fn, ops::plus>;
+
+        if constexpr(_is_identity_v<Op_fn, R, true> && std::is_same_v<_scalar_t<L>, scalar_t> && exact)
+            return (l);
+        else if constexpr(_is_identity_v<Op_fn, L, false> && std::is_same_v<_scalar_t<R>, scalar_t> && exact)
+            return (r);
+        else if constexpr(std::is_same_v<Op_fn, ops::multiplies> && _can_merge_factors<L, R>())
+            return _merge_factors(l, r);
+        else if constexpr(std::is_same_v<Op_fn, ops::multiplies> && _can_merge_factors<R, L>())
+            return _merge_factors(r, l);
+        else if constexpr(std::is_same_v<Op_fn, ops::divides> && traits::is_scalar_v<R> && std::is_floating_point_v<scalar_t> && _fast_math)
+            return _simplify(ops::multiplies{}, l, scalar_t(1) / static_cast<scalar_t>(r));
+        else
+            return operation{ op, l, r };
+    }
+
+    /// @brief Creates a unary operation, simplifying it where the result is unaffected
+    /// @details `-(-e)`, `~~e` and `+e` are `e` itself when the scalar type is unchanged
+    template<class Op_fn, class Expr>
+    inline constexpr _DD_OPERATION_T _simplify(const Op_fn op, const Expr& expr) noexcept
+    {
+        using scalar_t = _scalar_t<operation<Op_fn, Expr>>;
+
+        if constexpr(std::is_same_v<Op_fn, ops::unary_plus> && std::is_same_v<_scalar_t<Expr>, scalar_t>)
+            return (expr);
+        else if constexpr(_is_involution<Op_fn, Expr>::value)
+            return expr.template operand<0>();
+        else
+            return operation{ op, expr };
+    }
+
+    _DD_DEFINE_BINARY_OPERATOR(+, plus);
+    _DD_DEFINE_BINARY_OPERATOR(-, minus);
+    _DD_DEFINE_BINARY_OPERATOR(*, multiplies);
+    _DD_DEFINE_BINARY_OPERATOR(/, divides);
+    _DD_DEFINE_BINARY_OPERATOR(%, modulus);
+    _DD_DEFINE_BINARY_OPERATOR(&, bit_and);
+    _DD_DEFINE_BINARY_OPERATOR(|, bit_or);
+    _DD_DEFINE_BINARY_OPERATOR(^, bit_xor);
+    _DD_DEFINE_BINARY_OPERATOR(>>, shift_right);
+    _DD_DEFINE_BINARY_OPERATOR(<<, shift_left);
+
+    _DD_DEFINE_UNARY_OPERATOR(+, unary_plus);
+    _DD_DEFINE_UNARY_OPERATOR(-, negate);
+    _DD_DEFINE_UNARY_OPERATOR(~, bit_not);
+
+    _DD_DEFINE_BINARY_FUNCTION(min);
+    _DD_DEFINE_BINARY_FUNCTION(max);
+
+    /// @brief Creates an operation to clamp each component of a vector expression
+    /// @details Analogous to writing `expr.clamp(lo, hi)`
+    template<class Expr, class Lo, class Hi, traits::require<traits::is_expression_v<Expr>> = 1>
+    inline constexpr _DD_OPERATION_T clamp(const Expr& expr, const Lo& lo, const Hi& hi) noexcept
+    {
+        return expr.clamp(lo, hi);
+    }
+
+    /// @brief Creates an operation to linearly interpolate between two vector expressions
+    /// @details Analogous to writing `a.lerp(b, t)`
+    template<class Expr1, class Expr2, class T, traits::require<traits::is_expression_v<Expr1>> = 1>
+    inline constexpr _DD_OPERATION_T lerp(const Expr1& a, const Expr2& b, const T& t) noexcept
+    {
+        return a.lerp(b, t);
+    }
 
     template<class Expr1, class Expr2, traits::require<traits::is_same_size_v<Expr1, Expr2>> = 1>
     inline constexpr bool operator==(const Expr1& expr1, const Expr2& expr2) noexcept
@@ -315,6 +1621,8 @@ namespace impl
         template<class Other, traits::require<traits::has_converter_v<vector_t, Other>> = 1>
         operator Other() const
         {
+            _DD_INSTRUMENT(conversion, Child);
+
             Other other;
             converter<vector_t, Other>::convert(_child(), other);
             return other;
@@ -394,9 +1702,9 @@ namespace impl
 
         /// @brief Calculates the Euclidian length
         /// @details Analagous to writing `std::sqrt(vector.length2())`
-        double length() const
+        constexpr double length() const
         {
-            return std::sqrt((double)length2());
+            return math::sqrt((double)length2());
         }
 
         /// @brief Calculates the Euclidian distance to another vector expression squared
@@ -411,73 +1719,194 @@ namespace impl
         template<class Expr, traits::require<traits::is_same_size_v<Expr, Child>> = 1>
         constexpr double distance(const Expr& expr) const
         {
-            return std::sqrt((double)distance2(expr));
+            return math::sqrt((double)distance2(expr));
         }
 
         /// @brief Calculates the normalized vector
         /// @details Analagous to writing `vector / vector.length()`
-        value<double, size> normalize() const
+        constexpr value<double, size> normalize() const
         {
             return _child() / length();
         }
 
-        /// @brief Sets the Euclidian length
-        /// @details Analogous to writing `vector.normalize() * length`
-        value<double, size> set_length(const double length) const noexcept
+        /// @brief Sets the Euclidian length
+        /// @details Analogous to writing `vector.normalize() * length`
+        constexpr value<double, size> set_length(const double length) const noexcept
+        {
+            return normalize() * length;
+        }
+
+        /// @brief Calculates the delta angle to another vector expression
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               angle is approximated in the precision of the scalar type
+        template<class Expr, class Policy = math::precise_t, traits::require<traits::is_same_size_v<Expr, Child> && math::is_policy_v<Policy>> = 1>
+        constexpr double delta_angle(const Expr& expr, const Policy policy = {}) const
+        {
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+
+            return math::acos(dot(expr) / math::sqrt((real_t)length2() * (real_t)expr.length2()), policy);
+        }
+
+        /// @brief Creates an operation to apply a function to all components
+        template<class Fn, traits::require<std::is_invocable_v<Fn, scalar_t>> = 1>
+        constexpr _DD_OPERATION_T apply(const Fn& fn) const noexcept
+        {
+            return operation{ fn, _child() };
+        }
+
+        /// @brief Creates an operation to take the absolute value of each component
+        constexpr _DD_OPERATION_T abs() const noexcept
+        {
+           static_assert(std::is_signed_v<scalar_t>, "Cannot take the absolute value of an unsigned vector type");
+           return operation{ ops::abs{}, _child() };
+        }
+
+        /// @brief Creates an operation to round each component
+        constexpr _DD_OPERATION_T round() const noexcept
+        {
+            static_assert(std::is_floating_point_v<scalar_t>, "Cannot round an integer");
+            return operation{ ops::round{}, _child() };
+        }
+
+        /// @brief Creates an operation to floor each component
+        constexpr _DD_OPERATION_T floor() const noexcept
+        {
+            static_assert(std::is_floating_point_v<scalar_t>, "Cannot floor an integer");
+            return operation{ ops::floor{}, _child() };
+        }
+
+        /// @brief Creates an operation to ceil each component
+        constexpr _DD_OPERATION_T ceil() const noexcept
+        {
+            static_assert(std::is_floating_point_v<scalar_t>, "Cannot take the ceiling of an integer");
+            return operation{ ops::ceil{}, _child() };
+        }
+
+        /// @brief Creates an operation to take the componentwise minimum with another vector
+        ///        expression or a scalar
+        template<class T, traits::require<traits::is_valid_operation_v<Child, T, true>> = 1>
+        constexpr _DD_OPERATION_T min(const T& other) const noexcept
+        {
+            return impl::min(_child(), other);
+        }
+
+        /// @brief Creates an operation to take the componentwise maximum with another vector
+        ///        expression or a scalar
+        template<class T, traits::require<traits::is_valid_operation_v<Child, T, true>> = 1>
+        constexpr _DD_OPERATION_T max(const T& other) const noexcept
+        {
+            return impl::max(_child(), other);
+        }
+
+        /// @brief Creates an operation to clamp each component between two bounds
+        /// @details The bounds can be vector expressions of the same size or scalars
+        template<class Lo, class Hi, traits::require<traits::is_valid_operation_v<Child, Lo, true> &&
+                                                     traits::is_valid_operation_v<Child, Hi, true>> = 1>
+        constexpr _DD_OPERATION_T clamp(const Lo& lo, const Hi& hi) const noexcept
+        {
+            return operation{ ops::clamp{}, _child(), lo, hi };
+        }
+
+        /// @brief Creates an operation to linearly interpolate towards another vector expression
+        /// @details Evaluates to exactly `*this` when `t` is 0 and to exactly `expr` when `t` is 1
+        /// @param t The interpolation factor, either a scalar or a vector expression of the same size
+        template<class Expr, class T, traits::require<traits::is_same_size_v<Expr, Child> &&
+                                                      traits::is_valid_operation_v<Child, T, true>> = 1>
+        constexpr _DD_OPERATION_T lerp(const Expr& expr, const T& t) const noexcept
+        {
+            return operation{ ops::lerp{}, _child(), expr, t };
+        }
+
+        /// @brief Creates an operation to take the square root of each component
+        /// @details Integer components are promoted to `double`
+        constexpr _DD_OPERATION_T sqrt() const noexcept
+        {
+            return operation{ ops::sqrt{}, _child() };
+        }
+
+        /// @brief Creates an operation to take the exponential of each component
+        /// @details Integer components are promoted to `double`. See `math::exp` for error bounds
+        constexpr _DD_OPERATION_T exp() const noexcept
+        {
+            return operation{ ops::exp{}, _child() };
+        }
+
+        /// @brief Creates an operation to take the sine of each component
+        /// @details Integer components are promoted to `double`. See `math::sincos` for error bounds
+        constexpr _DD_OPERATION_T sin() const noexcept
         {
-            return normalize() * length;
+            return operation{ ops::sin{}, _child() };
         }
 
-        /// @brief Calculates the delta angle to another vector expression
-        template<class Expr, traits::require<traits::is_same_size_v<Expr, Child>> = 1>
-        double delta_angle(const Expr& expr) const
+        /// @brief Creates an operation to take the cosine of each component
+        /// @details Integer components are promoted to `double`. See `math::sincos` for error bounds
+        constexpr _DD_OPERATION_T cos() const noexcept
         {
-            return std::acos(dot(expr) / std::sqrt((double)length2() * expr.length2()));
+            return operation{ ops::cos{}, _child() };
         }
 
-        /// @brief Creates an operation to apply a function to all components
-        template<class Fn, traits::require<std::is_invocable_v<Fn, scalar_t>> = 1>
-        constexpr _DD_OPERATION_T apply(const Fn& fn) const noexcept
+        /// @brief Calculates the sine and cosine of each component in a single pass
+        /// @details Returns the vector values `{ sin, cos }`
+        std::pair<value<math::real_t<scalar_t>, size>, value<math::real_t<scalar_t>, size>> sincos() const noexcept
         {
-            return operation{ fn, _child() };
+            value<math::real_t<scalar_t>, size> sin, cos;
+
+            for (size_t i = 0; i < size; i++)
+                math::sincos(static_cast<math::real_t<scalar_t>>(at(i)), sin[i], cos[i]);
+            return { sin, cos };
         }
 
-        /// @brief Creates an operation to take the absolute value of each component
-        constexpr _DD_OPERATION_T abs() const noexcept
+        /// @brief Creates an operation to cast each component
+        template<class Scalar>
+        constexpr _DD_OPERATION_T scalar_cast() const noexcept
         {
-           static_assert(std::is_signed_v<scalar_t>, "Cannot take the absolute value of an unsigned vector type");
-           return apply([](scalar_t v) { return std::abs(v); });
+            static_assert(std::is_arithmetic_v<Scalar>, "Cannot scalar cast vector to non-arithmetic type");
+            return operation{ ops::cast<Scalar>{}, _child() };
         }
 
-        /// @brief Creates an operation to round each component
-        constexpr _DD_OPERATION_T round() const noexcept
+        /// @brief Creates a view of the components at the specified indices
+        /// @details Views are vector expressions referring to the components of this expression
+        ///          without copying them. Views of vector values are writable:
+        ///          `v.swizzle<1, 0>() = u` assigns `u[0]` to `v[1]` and `u[1]` to `v[0]`
+        template<size_t... Indices>
+        constexpr view<const Child, Indices...> swizzle() const noexcept
         {
-            static_assert(std::is_floating_point_v<scalar_t>, "Cannot round an integer");
-            return apply([](scalar_t v) { return std::round(v); });
+            return { _child() };
         }
 
-        /// @brief Creates an operation to floor each component
-        constexpr _DD_OPERATION_T floor() const noexcept
+        /// @brief Creates a view of the components at the specified indices
+        /// @details Views are vector expressions referring to the components of this expression
+        ///          without copying them. Views of vector values are writable:
+        ///          `v.swizzle<1, 0>() = u` assigns `u[0]` to `v[1]` and `u[1]` to `v[0]`
+        template<size_t... Indices>
+        constexpr view<Child, Indices...> swizzle() noexcept
         {
-            static_assert(std::is_floating_point_v<scalar_t>, "Cannot floor an integer");
-            return apply([](scalar_t v) { return std::floor(v); });
+            return { _child() };
         }
 
-        /// @brief Creates an operation to ceil each component
-        constexpr _DD_OPERATION_T ceil() const noexcept
+        /// @brief Creates a view of the components in the index range [First, Last)
+        template<size_t First, size_t Last>
+        constexpr _DD_OPERATION_T slice() const noexcept
         {
-            static_assert(std::is_floating_point_v<scalar_t>, "Cannot take the ceiling of an integer");
-            return apply([](scalar_t v) { return std::ceil(v); });
+            static_assert(First + 1 < Last && Last <= size, "Invalid slice range");
+            return _slice<First>(_child(), std::make_index_sequence<Last - First>());
         }
 
-        /// @brief Creates an operation to cast each component
-        template<class Scalar>
-        constexpr _DD_OPERATION_T scalar_cast() const noexcept
+        /// @brief Creates a view of the components in the index range [First, Last)
+        template<size_t First, size_t Last>
+        constexpr _DD_OPERATION_T slice() noexcept
         {
-            static_assert(std::is_arithmetic_v<Scalar>, "Cannot scalar cast vector to non-arithmetic type");
-            return apply([](scalar_t v) { return static_cast<Scalar>(v); });
+            static_assert(First + 1 < Last && Last <= size, "Invalid slice range");
+            return _slice<First>(_child(), std::make_index_sequence<Last - First>());
         }
 
+        /// @brief Named two and three component swizzles, e.g. `v.xy()` or `v.zyx()`
+        /// @details Analogous to writing `v.swizzle<0, 1>()` and `v.swizzle<2, 1, 0>()`
+        _DD_DEFINE_SWIZZLES(x)
+        _DD_DEFINE_SWIZZLES(y)
+        _DD_DEFINE_SWIZZLES(z)
+        _DD_DEFINE_SWIZZLES(w)
+
         /// @brief Serializes the vector to a string
         /// @param name Can be provided to differentiate between multiple vectors
         std::string to_string(const std::string& name = "") const noexcept
@@ -498,6 +1927,17 @@ namespace impl
         {
             return static_cast<const Child&>(*this);
         }
+
+        constexpr Child& _child() noexcept
+        {
+            return static_cast<Child&>(*this);
+        }
+    private:
+        template<size_t First, class Expr, size_t... Indices>
+        static constexpr _DD_OPERATION_T _slice(Expr& expr, std::index_sequence<Indices...>) noexcept
+        {
+            return expr.template swizzle<(First + Indices)...>();
+        }
     };
     
     /// @defgroup Expressions
@@ -513,22 +1953,59 @@ namespace impl
     {
     protected:
         using base = expression_base<Child>;
+        using typename base::scalar_t;
         using typename base::vector_t;
     public:
         /// @brief Calculates the angle represented by the components
-        double angle() const noexcept
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               angle is approximated in the precision of the scalar type
+        template<class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+        constexpr double angle(const Policy policy = {}) const noexcept
         {
-            return std::atan2(base::at(1), base::at(0));
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+
+            return math::atan2((real_t)base::at(1), (real_t)base::at(0), policy);
         }
 
         /// @brief Constructs the vector value representation of an angle
-        static vector_t from_angle(const double angle) noexcept
+        /// @details The sine and cosine are computed jointly
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               components are approximated in the precision of the scalar type
+        template<class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+        static constexpr vector_t from_angle(const double angle, const Policy policy = {}) noexcept
         {
-            return
-            {
-                std::cos(angle),
-                std::sin(angle)
-            };
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+            real_t sin = 0, cos = 0;
+
+            math::sincos((real_t)angle, sin, cos, policy);
+            return { cos, sin };
+        }
+
+        /// @brief Converts to polar coordinates, the length and the angle
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               coordinates are approximated in the precision of the scalar type
+        template<class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+        constexpr auto to_polar(const Policy policy = {}) const noexcept
+        {
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+            const real_t x = (real_t)base::at(0), y = (real_t)base::at(1);
+
+            return value<real_t, 2>(math::sqrt(x * x + y * y), math::atan2(y, x, policy));
+        }
+
+        /// @brief Constructs the vector value from polar coordinates, the length and the angle
+        /// @details Analogous to writing `from_angle(polar[1], policy) * polar[0]`
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               components are approximated in the precision of the scalar type
+        template<class Expr, class Policy = math::precise_t, traits::require<traits::size_v<Expr> == 2 && math::is_policy_v<Policy>> = 1>
+        static constexpr vector_t from_polar(const Expr& polar, const Policy policy = {}) noexcept
+        {
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+            const real_t length = (real_t)polar[0];
+            real_t sin = 0, cos = 0;
+
+            math::sincos((real_t)polar[1], sin, cos, policy);
+            return { length * cos, length * sin };
         }
     };
 
@@ -539,6 +2016,7 @@ namespace impl
     {
     protected:
         using base = expression_base<Child>;
+        using typename base::scalar_t;
         using typename base::vector_t;
     public:
         /// @brief Calculates the cross product with another vector expression
@@ -552,8 +2030,68 @@ namespace impl
                 base::at(0) * expr[1] - base::at(1) * expr[0]
             };
         }
+
+        /// @brief Converts to spherical coordinates, the length, the polar angle from the z-axis
+        ///        and the azimuthal angle in the xy-plane from the x-axis
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               coordinates are approximated in the precision of the scalar type
+        template<class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+        constexpr auto to_spherical(const Policy policy = {}) const noexcept
+        {
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+            const real_t x = (real_t)base::at(0), y = (real_t)base::at(1), z = (real_t)base::at(2);
+            const real_t planar2 = x * x + y * y;
+
+            return value<real_t, 3>(math::sqrt(planar2 + z * z), math::atan2(math::sqrt(planar2), z, policy), math::atan2(y, x, policy));
+        }
+
+        /// @brief Constructs the vector value from spherical coordinates, the length, the polar
+        ///        angle from the z-axis and the azimuthal angle in the xy-plane from the x-axis
+        /// @param policy Either `math::precise` (the default) or `math::fast`, in which case the
+        ///               components are approximated in the precision of the scalar type
+        template<class Expr, class Policy = math::precise_t, traits::require<traits::size_v<Expr> == 3 && math::is_policy_v<Policy>> = 1>
+        static constexpr vector_t from_spherical(const Expr& spherical, const Policy policy = {}) noexcept
+        {
+            using real_t = std::conditional_t<std::is_same_v<Policy, math::fast_t>, math::real_t<scalar_t>, double>;
+            const real_t length = (real_t)spherical[0];
+            real_t polar_sin = 0, polar_cos = 0, azimuth_sin = 0, azimuth_cos = 0;
+
+            math::sincos((real_t)spherical[1], polar_sin, polar_cos, policy);
+            math::sincos((real_t)spherical[2], azimuth_sin, azimuth_cos, policy);
+
+            const real_t planar = length * polar_sin;
+            return { planar * azimuth_cos, planar * azimuth_sin, length * polar_cos };
+        }
     };
     
+    /// @brief Expression operands are referred to, scalar operands are stored by value
+    template<class T>
+    using _operand_t = std::conditional_t<traits::is_expression_v<T>, const T&, T>;
+
+    template<size_t Index, class T>
+    struct _operand_leaf
+    {
+        T value;
+    };
+
+    /// @brief Holds the operands of an operation
+    /// @details Used instead of `std::tuple`, which is considerably more expensive to instantiate
+    ///          for every node of every expression
+    template<class Indices, class... Ts>
+    struct _operand_list;
+
+    template<size_t... Indices, class... Ts>
+    struct _operand_list<std::index_sequence<Indices...>, Ts...> : _operand_leaf<Indices, Ts>...
+    {
+        constexpr _operand_list(const Ts&... values) noexcept : _operand_leaf<Indices, Ts>{ values }... {}
+    };
+
+    template<size_t Index, class T>
+    inline constexpr const T& _get(const _operand_leaf<Index, T>& leaf) noexcept
+    {
+        return leaf.value;
+    }
+
     /// @brief Acts as an intermediary type for operations involving expressions
     /// @param Op_fn The function type to apply to the operands
     /// @param Operands Types of the operands
@@ -578,11 +2116,8 @@ namespace impl
         /// @brief Evaluates component at an index
         constexpr scalar_t operator[](const size_t index) const
         {
-            auto evaulate_index = [&](const Operands&... args)
-            {
-                return _op(_get_operand_at(args, index)...);
-            };
-            return std::apply(evaulate_index, _operands);
+            _DD_INSTRUMENT(evaluation, operation);
+            return _evaluate_at(index, std::index_sequence_for<Operands...>());
         }
 
         /// @brief Evaluates vector operation to a vector value
@@ -596,9 +2131,26 @@ namespace impl
         {
             return vector_t(*this);
         }
+
+        /// @brief Gets the operand at an index
+        /// @details Expression operands are referred to, scalar operands are stored by value
+        template<size_t Index>
+        constexpr const auto& operand() const noexcept
+        {
+            return _get<Index>(_operands);
+        }
     private:
+
+        template<size_t... Indices>
+        constexpr scalar_t _evaluate_at(const size_t index, std::index_sequence<Indices...>) const
+        {
+            return _op(_get_operand_at(_get<Indices>(_operands), index)...);
+        }
+
+        /// @brief Gets the operand component at an index in its own scalar type, so that `Op_fn`
+        ///        sees the operands as they are rather than converted to the result type
         template<class T>
-        static constexpr scalar_t _get_operand_at(const T& value, const size_t index)
+        static constexpr auto _get_operand_at(const T& value, const size_t index)
         {
             if constexpr(traits::is_expression_v<T>)
                 return value[index];
@@ -607,20 +2159,151 @@ namespace impl
         }
 
         const Op_fn _op;
-        const std::tuple<const Operands&...> _operands;
+        const _operand_list<std::index_sequence_for<Operands...>, _operand_t<Operands>...> _operands;
+    };
+
+    /// @brief A vector expression referring to a selection of the components of another expression
+    /// @details Created through swizzles and slices. Views of mutable vector values are writable;
+    ///          other views are read-only
+    /// @param Expr The type of the referred expression, `const`-qualified if read-only
+    /// @param Indices The indices of the referred components
+    template<class Expr, size_t... Indices>
+    struct view : expression<view<Expr, Indices...>>
+    {
+    private:
+        using base = expression<view>;
+        static constexpr size_t _indices[] = { Indices... };
+        static constexpr bool _writable = traits::is_value_v<Expr>; // false for `const` values
+
+        static constexpr bool _unique() noexcept
+        {
+            for (size_t i = 0; i < sizeof...(Indices); i++)
+            {
+                for (size_t j = 0; j < i; j++)
+                {
+                    if (_indices[i] == _indices[j])
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        static_assert(sizeof...(Indices) > 1, "A view must contain at least two components");
+        static_assert(((Indices < traits::size_v<std::remove_const_t<Expr>>) && ...), "View index out of range");
+    public:
+        /// @brief The scalar type of the view
+        using scalar_t = typename base::scalar_t;
+
+        /// @brief The vector size of the view
+        static constexpr size_t size = base::size;
+
+        /// @brief The vector type of the view
+        using vector_t = typename base::vector_t;
+
+        /// @brief Constructs a view of an expression
+        constexpr view(Expr& expr) noexcept : _expr(expr) {}
+
+        /// @brief Assigns to the referred components
+        /// @details The source is evaluated in full first, so overlapping assignments such as
+        ///          `v.xy() = v.yx()` behave as if `v.yx()` was copied beforehand
+        template<class Other, traits::require<traits::is_same_size_v<view, Other>> = 1>
+        constexpr view& operator=(const Other& other) noexcept
+        {
+            return _assign(other);
+        }
+
+        /// @brief Assigns to the referred components
+        constexpr view& operator=(const view& other) noexcept
+        {
+            return _assign(other);
+        }
+
+        /// @brief Gets the component value at an index
+        constexpr scalar_t operator[](const size_t index) const noexcept
+        {
+            return _expr[_indices[index]];
+        }
+
+        /// @brief Gets a reference to the component at an index
+        template<bool Writable = _writable, traits::require<Writable> = 1>
+        constexpr scalar_t& operator[](const size_t index) noexcept
+        {
+            return _expr[_indices[index]];
+        }
+
+        /// @brief Creates a view of the components at the specified indices of this view
+        /// @details Refers directly to the underlying expression, e.g. `v.zyx().xy()` is `v.zy()`
+        template<size_t... Others>
+        constexpr view<Expr, _indices[Others]...> swizzle() const noexcept
+        {
+            return { _expr };
+        }
+
+        /// @brief Evaluates the view to a vector value
+        constexpr vector_t operator*() const noexcept
+        {
+            return evaluate();
+        }
+
+        /// @brief Evaluates the view to a vector value
+        constexpr vector_t evaluate() const noexcept
+        {
+            return vector_t(*this);
+        }
+
+        template<class Other, traits::require<traits::is_valid_operation_v<view, Other, true>> = 1>
+        constexpr view& operator+=(const Other& other) noexcept
+        {
+            return *this = *this + other;
+        }
+
+        template<class Other, traits::require<traits::is_valid_operation_v<view, Other, true>> = 1>
+        constexpr view& operator-=(const Other& other) noexcept
+        {
+            return *this = *this - other;
+        }
+
+        template<class Other, traits::require<traits::is_valid_operation_v<view, Other, true>> = 1>
+        constexpr view& operator*=(const Other& other) noexcept
+        {
+            return *this = *this * other;
+        }
+
+        template<class Other, traits::require<traits::is_valid_operation_v<view, Other, true>> = 1>
+        constexpr view& operator/=(const Other& other) noexcept
+        {
+            return *this = *this / other;
+        }
+    private:
+        template<class Other>
+        constexpr view& _assign(const Other& other) noexcept
+        {
+            static_assert(_writable, "Cannot assign to a view of a constant or of an operation");
+            static_assert(_unique(), "Cannot assign to a view with repeated components");
+
+            const vector_t values = other;
+
+            for (size_t i = 0; i < size; i++)
+                _expr[_indices[i]] = values[i];
+            return *this;
+        }
+
+        Expr& _expr;
     };
     
     /// @defgroup ValueData
     /// @brief Defines the vector value data
-    /// @details The data is stored as a `Scalar data[Size]`. There are also specializations
-    ///          defined which add named components if a compatible compiler is used
+    /// @details The data is stored as a `Scalar data[Capacity]`, where `Capacity` is `Size` for
+    ///          regular values and the padded size for aligned values. There are also
+    ///          specializations defined which add named components if a compatible compiler
+    ///          is used
 
     /// @ingroup ValueData
-    /// @brief Default case: only contains a `Scalar data[Size]` array
-    template<class Scalar, size_t Size>
+    /// @brief Default case: only contains a `Scalar data[Capacity]` array
+    template<class Scalar, size_t Size, size_t Capacity = Size>
     struct value_data
     {
-        Scalar data[Size];
+        Scalar data[Capacity];
     protected:
         template<class... Scalars>
         constexpr value_data(Scalars... scalars) noexcept : data{ scalars... } {}
@@ -628,12 +2311,12 @@ namespace impl
 
     /// @ingroup ValueData
     /// @brief Specialization for 2D vectors: adds component names `x`, `y`
-    template<class Scalar>
-    struct value_data<Scalar, 2>
+    template<class Scalar, size_t Capacity>
+    struct value_data<Scalar, 2, Capacity>
     {
         union
         {
-            Scalar data[2];
+            Scalar data[Capacity];
 
             struct
             {
@@ -647,12 +2330,12 @@ namespace impl
 
     /// @ingroup ValueData
     /// @brief Specialization for 3D vectors: adds component names `x`, `y`, `z`
-    template<class Scalar>
-    struct value_data<Scalar, 3>
+    template<class Scalar, size_t Capacity>
+    struct value_data<Scalar, 3, Capacity>
     {
         union
         {
-            Scalar data[3];
+            Scalar data[Capacity];
 
             struct
             {
@@ -666,12 +2349,12 @@ namespace impl
 
     /// @ingroup ValueData
     /// @brief Specialization for 4D vectors: adds component names `x`, `y`, `z`, `w`
-    template<class Scalar>
-    struct value_data<Scalar, 4>
+    template<class Scalar, size_t Capacity>
+    struct value_data<Scalar, 4, Capacity>
     {
         union
         {
-            Scalar data[4];
+            Scalar data[Capacity];
 
             struct
             {
@@ -683,16 +2366,29 @@ namespace impl
         constexpr value_data(Scalars... scalars) noexcept : data{ scalars... } {}
     };
 
+    /// @brief Gets the smallest power of two not less than `n`
+    constexpr size_t _next_pow2(const size_t n) noexcept
+    {
+        size_t out = 1;
+
+        while (out < n)
+            out *= 2;
+        return out;
+    }
+
     /// @brief A vector expression containing a single vector value
     /// @param Scalar The scalar type of the vector
     /// @param Size The size of the vector
-    template<class Scalar, size_t Size>
-    struct value : expression<value<Scalar, Size>>, value_data<Scalar, Size>
+    /// @param Aligned If true, the components are padded with zeroes to the next power of two
+    ///                and the value is aligned to its padded size (see `aligned_vector`)
+    template<class Scalar, size_t Size, bool Aligned>
+    struct alignas(Aligned ? _next_pow2(Size) * sizeof(Scalar) : alignof(Scalar)) value
+        : expression<value<Scalar, Size, Aligned>>, value_data<Scalar, Size, Aligned ? _next_pow2(Size) : Size>
     {
         static_assert(std::is_arithmetic_v<Scalar> && (Size > 1), "Invalid vector scalar_t or size");
     private:
         using base = expression<value>;
-        using value_data = value_data<Scalar, Size>;
+        using value_data = impl::value_data<Scalar, Size, Aligned ? _next_pow2(Size) : Size>;
     public:
         using value_data::data;
         
@@ -701,6 +2397,9 @@ namespace impl
 
         /// @brief The vector size of the value
         static constexpr size_t size = base::size;
+
+        /// @brief The number of stored components, including the zeroed padding of aligned values
+        static constexpr size_t capacity = Aligned ? _next_pow2(Size) : Size;
         
         /// @defgroup Prefabs
         /// @brief Prefabricated vector values
@@ -743,6 +2442,7 @@ namespace impl
         template<class Other, traits::require<traits::has_converter_v<value, Other>> = 1>
         constexpr value(const Other& other)
         {
+            _DD_INSTRUMENT(conversion, value);
             converter<value, Other>::convert(other, *this);
         }
 
@@ -767,11 +2467,22 @@ namespace impl
 
         /// @brief Copies component values from another vector expression
         /// @details Vector values are copied normally. Vector operations are evaluated and copied.
+        ///          Floating point expressions made up of aligned values only are evaluated
+        ///          over the padding as well, allowing full-width SIMD instructions to be used
         template<class Expr, traits::require<traits::is_same_size_v<value, Expr>> = 1>
         constexpr value& assign(const Expr& expr) noexcept
         {
-            for (size_t i = 0; i < size; i++)
+            constexpr size_t lanes = std::is_floating_point_v<Scalar> && traits::capacity_v<Expr> >= capacity ? capacity : size;
+
+            if constexpr(!traits::is_value_v<Expr>)
+            {
+                _DD_INSTRUMENT(materialization, Expr);
+            }
+
+            for (size_t i = 0; i < lanes; i++)
                 data[i] = expr[i];
+            for (size_t i = size; i < lanes; i++)
+                data[i] = 0; // keep the padding zeroed
             return *this;
         }
 
@@ -802,6 +2513,86 @@ namespace impl
             return data + size;
         }
     };
+
+    /// @brief Gets the name of a scalar type
+    template<class T>
+    constexpr std::string_view _scalar_name() noexcept
+    {
+        if constexpr(std::is_same_v<T, bool>)             return "bool";
+        else if constexpr(std::is_same_v<T, char>)        return "char";
+        else if constexpr(std::is_same_v<T, int8_t>)      return "int8_t";
+        else if constexpr(std::is_same_v<T, uint8_t>)     return "uint8_t";
+        else if constexpr(std::is_same_v<T, int16_t>)     return "int16_t";
+        else if constexpr(std::is_same_v<T, uint16_t>)    return "uint16_t";
+        else if constexpr(std::is_same_v<T, int32_t>)     return "int32_t";
+        else if constexpr(std::is_same_v<T, uint32_t>)    return "uint32_t";
+        else if constexpr(std::is_same_v<T, int64_t>)     return "int64_t";
+        else if constexpr(std::is_same_v<T, uint64_t>)    return "uint64_t";
+        else if constexpr(std::is_same_v<T, float>)       return "float";
+        else if constexpr(std::is_same_v<T, double>)      return "double";
+        else if constexpr(std::is_same_v<T, long double>) return "long double";
+        else if constexpr(std::is_signed_v<T>)            return "signed integer";
+        else                                              return "unsigned integer";
+    }
+
+    /// @brief Gets the name of the function applied by an operation
+    /// @details User functions, e.g. passed to `apply`, are named "apply"
+    template<class Op_fn, class = void>
+    inline constexpr std::string_view _function_name_v = "apply";
+
+    template<class Op_fn>
+    inline constexpr std::string_view _function_name_v<Op_fn, std::void_t<decltype(Op_fn::_name)>> = Op_fn::_name;
+
+    template<class Expr>
+    inline void _describe_vector(std::string& out)
+    {
+        using scalar_t = traits::scalar_t<Expr>;
+        constexpr size_t size = traits::size_v<Expr>;
+
+        out.append(std::is_same_v<Expr, value<scalar_t, size, true>> ? "aligned_vector<" : "vector<");
+        out.append(_scalar_name<scalar_t>());
+        out.append(", " + std::to_string(size) + ">");
+    }
+
+    /// @brief Appends one line per node of an expression tree, indented by depth
+    template<class T>
+    inline void _describe(std::string& out, const size_t depth)
+    {
+        out.append(2 * depth, ' ');
+
+        if constexpr(traits::is_constant_v<T>)
+            out.append("constant<" + std::to_string(T::value) + ">\n");
+        else if constexpr(!traits::is_expression_v<T>)
+            out.append(_scalar_name<T>()).append("\n");
+        else if constexpr(traits::is_value_v<T>)
+        {
+            _describe_vector<T>(out);
+            out.append("\n");
+        }
+        else
+            _describe_node(out, depth, static_cast<T*>(nullptr));
+    }
+
+    template<class Op_fn, class... Operands>
+    inline void _describe_node(std::string& out, const size_t depth, operation<Op_fn, Operands...>*)
+    {
+        out.append(_function_name_v<Op_fn>).append(" : ");
+        _describe_vector<operation<Op_fn, Operands...>>(out);
+        out.append("\n");
+        (_describe<Operands>(out, depth + 1), ...);
+    }
+
+    template<class Expr, size_t... Indices>
+    inline void _describe_node(std::string& out, const size_t depth, view<Expr, Indices...>*)
+    {
+        out.append("view<");
+        ((out.append(std::to_string(Indices)).append(", ")), ...);
+        out.resize(out.size() - 2);
+        out.append("> : ");
+        _describe_vector<view<Expr, Indices...>>(out);
+        out.append("\n");
+        _describe<std::remove_const_t<Expr>>(out, depth + 1);
+    }
 }
 
 /// @param Scalar The scalar type of the vector (e.g. `int` or `float`)
@@ -809,11 +2600,20 @@ namespace impl
 template<class Scalar, size_t Size>
 using vector = impl::value<Scalar, Size>;
 
-template<class S, size_t N>
-const vector<S, N> vector<S, N>::zero(0);
+/// @brief A vector padded with zeroes to the next power of two and aligned to its padded size
+/// @details E.g. `aligned_vector<float, 3>` occupies 16 bytes, allowing arrays of them to be
+///          processed with aligned 128-bit loads. Interoperates with `vector` through all
+///          operations; evaluating an operation yields a regular `vector`
+/// @param Scalar The scalar type of the vector (e.g. `int` or `float`)
+/// @param Size The size of the vector
+template<class Scalar, size_t Size>
+using aligned_vector = impl::value<Scalar, Size, true>;
+
+template<class S, size_t N, bool A>
+const impl::value<S, N, A> impl::value<S, N, A>::zero(0);
 
-template<class S, size_t N>
-const vector<S, N> vector<S, N>::identity(1);
+template<class S, size_t N, bool A>
+const impl::value<S, N, A> impl::value<S, N, A>::identity(1);
 
 namespace types
 {
@@ -851,9 +2651,229 @@ namespace types
     using double4d = vector<double,   4>;
 }
 
+// Explicit instantiations of the vector types above. Defining `DD_EXTERN_TEMPLATES` stops the
+// including translation units from instantiating their members, which are instead instantiated once
+// by a translation unit defining `DD_INSTANTIATE_TEMPLATES` (see src/instantiations.cpp)
+#if defined(DD_INSTANTIATE_TEMPLATES)
+#define _DD_INSTANTIATE(Scalar) template struct impl::value<Scalar, 2>; \
+                                template struct impl::value<Scalar, 3>; \
+                                template struct impl::value<Scalar, 4>;
+#elif defined(DD_EXTERN_TEMPLATES)
+#define _DD_INSTANTIATE(Scalar) extern template struct impl::value<Scalar, 2>; \
+                                extern template struct impl::value<Scalar, 3>; \
+                                extern template struct impl::value<Scalar, 4>;
+#endif
+
+#ifdef _DD_INSTANTIATE
+_DD_INSTANTIATE(bool)
+_DD_INSTANTIATE(int8_t)
+_DD_INSTANTIATE(uint8_t)
+_DD_INSTANTIATE(int32_t)
+_DD_INSTANTIATE(uint32_t)
+_DD_INSTANTIATE(int64_t)
+_DD_INSTANTIATE(uint64_t)
+_DD_INSTANTIATE(float)
+_DD_INSTANTIATE(double)
+#undef _DD_INSTANTIATE
+#endif
+
 // bring the vector types to the dd namespace
 using namespace types;
 
+// bring the vector functions to the dd namespace
+using impl::min;
+using impl::max;
+using impl::clamp;
+using impl::lerp;
+
+/// @brief Creates a view of the components of a vector expression in the index range [First, Last)
+/// @details Analogous to writing `expr.slice<First, Last>()`
+template<size_t First, size_t Last, class Expr, traits::require<traits::is_expression_v<std::remove_const_t<Expr>>> = 1>
+inline constexpr _DD_OPERATION_T slice(Expr& expr) noexcept
+{
+    return expr.template slice<First, Last>();
+}
+
+/// @brief Describes the tree of a vector expression type, one node per line
+/// @details E.g. for `(a + b) * 2.f`, where `a` and `b` are `float3d`:
+///
+///     multiplies : vector<float, 3>
+///       plus : vector<float, 3>
+///         vector<float, 3>
+///         vector<float, 3>
+///       float
+template<class Expr, traits::require<traits::is_expression_v<Expr>> = 1>
+inline std::string describe()
+{
+    std::string out;
+    impl::_describe<Expr>(out, 0);
+    return out;
+}
+
+/// @brief Describes the tree of a vector expression, one node per line
+/// @details Analogous to writing `describe<decltype(expr)>()`
+template<class Expr, traits::require<traits::is_expression_v<Expr>> = 1>
+inline std::string describe(const Expr&)
+{
+    return describe<Expr>();
+}
+
+// bring the precision tags to the dd namespace
+using math::precise;
+using math::fast;
+
+/// @brief Calculates the angles of an array of 2D vectors
+/// @details Analogous to calling `angle(policy)` on each vector
+template<class Scalar, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void angles(const vector<Scalar, 2>* in, math::real_t<Scalar>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = static_cast<math::real_t<Scalar>>(in[i].angle(policy));
+}
+
+/// @brief Constructs the vector value representations of an array of angles
+/// @details Analogous to calling `from_angle(angle, policy)` for each angle
+template<class Scalar, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void from_angles(const math::real_t<Scalar>* in, vector<Scalar, 2>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = vector<Scalar, 2>::from_angle(in[i], policy);
+}
+
+namespace impl
+{
+    /// @brief The number of elements converted per block by the coordinate array kernels
+    inline constexpr size_t _conversion_block = 256;
+
+    /// @brief The angle computation of the coordinate array kernels: the vectorized `math::atan2`
+    ///        kernel in the precise mode, rather than `std::atan2`
+    template<class T, class Policy>
+    inline T _block_atan2(const T y, const T x, const Policy policy) noexcept
+    {
+        if constexpr(std::is_same_v<Policy, math::fast_t>)
+            return math::atan2(y, x, policy);
+        else
+            return math::atan2(y, x);
+    }
+}
+
+/// @brief Converts an array of 2D vectors to polar coordinates
+/// @details Analogous to calling `to_polar(policy)` on each vector, but computed in the precision
+///          of the scalar type in either mode. The array is processed in blocks, with the square
+///          roots in a loop of their own, since `std::sqrt` is vectorized only with -fno-math-errno
+///          while the loops of the math kernels are vectorized regardless. In the precise mode the
+///          angles are computed by the `math::atan2` kernel; see it for the error bounds
+template<class Scalar, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void to_polar(const vector<Scalar, 2>* in, vector<math::real_t<Scalar>, 2>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    using real_t = math::real_t<Scalar>;
+    real_t x[impl::_conversion_block], y[impl::_conversion_block], length[impl::_conversion_block];
+
+    for (size_t begin = 0; begin < count; begin += impl::_conversion_block)
+    {
+        const size_t block = std::min(impl::_conversion_block, count - begin);
+
+        for (size_t i = 0; i < block; i++)
+        {
+            x[i] = static_cast<real_t>(in[begin + i][0]);
+            y[i] = static_cast<real_t>(in[begin + i][1]);
+            length[i] = x[i] * x[i] + y[i] * y[i];
+        }
+        for (size_t i = 0; i < block; i++)
+            length[i] = math::sqrt(length[i]);
+
+        for (size_t i = 0; i < block; i++)
+        {
+            out[begin + i][0] = length[i];
+            out[begin + i][1] = impl::_block_atan2(y[i], x[i], policy);
+        }
+    }
+}
+
+/// @brief Constructs the 2D vectors of an array of polar coordinates
+/// @details Analogous to calling `from_polar(polar, policy)` for each element, but computed in the
+///          precision of the scalar type in either mode
+template<class Scalar, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void from_polar(const vector<math::real_t<Scalar>, 2>* in, vector<Scalar, 2>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    using real_t = math::real_t<Scalar>;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        real_t sin = 0, cos = 0;
+        math::sincos(in[i][1], sin, cos, policy);
+
+        out[i][0] = static_cast<Scalar>(in[i][0] * cos);
+        out[i][1] = static_cast<Scalar>(in[i][0] * sin);
+    }
+}
+
+/// @brief Converts an array of 3D vectors to spherical coordinates
+/// @details Analogous to calling `to_spherical(policy)` on each vector, but computed in the
+///          precision of the scalar type in either mode. Blocked like `to_polar`
+template<class Scalar, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void to_spherical(const vector<Scalar, 3>* in, vector<math::real_t<Scalar>, 3>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    using real_t = math::real_t<Scalar>;
+    real_t x[impl::_conversion_block], y[impl::_conversion_block], z[impl::_conversion_block];
+    real_t planar[impl::_conversion_block], length[impl::_conversion_block];
+
+    for (size_t begin = 0; begin < count; begin += impl::_conversion_block)
+    {
+        const size_t block = std::min(impl::_conversion_block, count - begin);
+
+        for (size_t i = 0; i < block; i++)
+        {
+            x[i] = static_cast<real_t>(in[begin + i][0]);
+            y[i] = static_cast<real_t>(in[begin + i][1]);
+            z[i] = static_cast<real_t>(in[begin + i][2]);
+            planar[i] = x[i] * x[i] + y[i] * y[i];
+            length[i] = planar[i] + z[i] * z[i];
+        }
+        for (size_t i = 0; i < block; i++)
+        {
+            planar[i] = math::sqrt(planar[i]);
+            length[i] = math::sqrt(length[i]);
+        }
+        for (size_t i = 0; i < block; i++)
+        {
+            out[begin + i][0] = length[i];
+            out[begin + i][1] = impl::_block_atan2(planar[i], z[i], policy);
+            out[begin + i][2] = impl::_block_atan2(y[i], x[i], policy);
+        }
+    }
+}
+
+/// @brief Constructs the 3D vectors of an array of spherical coordinates
+/// @details Analogous to calling `from_spherical(spherical, policy)` for each element, but
+///          computed in the precision of the scalar type in either mode
+template<class Scalar, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void from_spherical(const vector<math::real_t<Scalar>, 3>* in, vector<Scalar, 3>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    using real_t = math::real_t<Scalar>;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        real_t polar_sin = 0, polar_cos = 0, azimuth_sin = 0, azimuth_cos = 0;
+        math::sincos(in[i][1], polar_sin, polar_cos, policy);
+        math::sincos(in[i][2], azimuth_sin, azimuth_cos, policy);
+
+        const real_t planar = in[i][0] * polar_sin;
+        out[i][0] = static_cast<Scalar>(planar * azimuth_cos);
+        out[i][1] = static_cast<Scalar>(planar * azimuth_sin);
+        out[i][2] = static_cast<Scalar>(in[i][0] * polar_cos);
+    }
+}
+
+/// @brief Calculates the delta angles between two arrays of vectors
+/// @details Analogous to calling `a[i].delta_angle(b[i], policy)` for each pair
+template<class Scalar, size_t Size, class Policy = math::precise_t, traits::require<math::is_policy_v<Policy>> = 1>
+inline void delta_angles(const vector<Scalar, Size>* a, const vector<Scalar, Size>* b, math::real_t<Scalar>* out, const size_t count, const Policy policy = {}) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = static_cast<math::real_t<Scalar>>(a[i].delta_angle(b[i], policy));
+}
+
 
 _DD_NAMESPACE_CLOSE
 
@@ -869,11 +2889,13 @@ namespace std
     }
 
     /// @brief Hash specialization for use in `std::unordered_*` containers
-    template<class Scalar, size_t Size>
-    struct hash<dd::vector<Scalar, Size>>
+    template<class Scalar, size_t Size, bool Aligned>
+    struct hash<dd::impl::value<Scalar, Size, Aligned>>
     {
-        size_t operator()(const dd::vector<Scalar, Size>& v) const
+        size_t operator()(const dd::impl::value<Scalar, Size, Aligned>& v) const
         {
+            _DD_INSTRUMENT(hash, dd::impl::value<Scalar, Size, Aligned>);
+
             // interpret data as a string_view and use the string_view hasher
 
             const std::string_view byte_data = { reinterpret_cast<const char*>(v.data), Size * sizeof(Scalar) };
@@ -0,0 +1,273 @@
+#pragma once
+#include "parallel.h"
+#include <memory>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief A uniform grid of points for neighbour searches, stored as a spatial hash
+/// @details Points are binned into the integer cells `floor(position / cell_size)`, which are hashed
+///          into a table of buckets. The points are stored contiguously, sorted by bucket with a
+///          stable counting sort, and each bucket is a range of that array (compressed sparse rows);
+///          the points of a cell are thus adjacent in memory, in the order they were given.
+///
+///          The grid is rebuilt from scratch rather than updated, e.g. once per frame of a simulation,
+///          on several threads if requested. For radius queries the cell size should be about the
+///          query radius. Querying the neighbours of every point is about twice as fast in storage
+///          order (`positions()`) as in the order given, since consecutive queries then visit the
+///          same buckets
+/// @param T The type of the values stored with the points, e.g. particle indices
+/// @param Allocator Allocator for the internal arrays, rebound to the element types
+template<class Scalar, size_t Size, class T = uint32_t, class Allocator = std::allocator<T>>
+class spatial_grid
+{
+public:
+    using vector_t = vector<Scalar, Size>;
+    using cell_t = vector<int32_t, Size>;
+    using value_t = T;
+
+    static_assert(std::is_floating_point_v<Scalar>, "Spatial grids have to be of a floating point type");
+
+    /// @param cell_size The edge length of the cells
+    explicit spatial_grid(const Scalar cell_size, const Allocator& allocator = Allocator())
+        : _cell_size(cell_size), _inverse_cell_size(Scalar(1) / cell_size), _starts(_index_allocator_t(allocator)),
+          _counts(_index_allocator_t(allocator)), _buckets(_index_allocator_t(allocator)), _positions(_vector_allocator_t(allocator)),
+          _cells(_cell_allocator_t(allocator)), _values(allocator)
+    {}
+
+    /// @brief Builds the grid from arrays of positions and values
+    /// @param count The number of points, less than 2^32
+    /// @param threads The number of threads sorting the points, 0 for `default_thread_count()`. The
+    ///                result does not depend on it, but each thread counts into a table of its own
+    void build(const vector_t* positions, const T* values, const size_t count, const size_t threads = 1)
+    {
+        _build(positions, count, threads, [&](const size_t i) -> const T& { return values[i]; });
+    }
+
+    /// @brief Builds the grid from an array of positions, storing the index of each point as its value
+    template<class U = T, traits::require<std::is_integral_v<U>> = 1>
+    void build(const vector_t* positions, const size_t count, const size_t threads = 1)
+    {
+        _build(positions, count, threads, [](const size_t i) { return T(i); });
+    }
+
+    /// @brief Gets the cell containing a position
+    cell_t cell_of(const vector_t& position) const noexcept
+    {
+        return (position * _inverse_cell_size).floor().template scalar_cast<int32_t>();
+    }
+
+    /// @brief Calls `fn(position, value)` for each point in a cell
+    template<class Fn>
+    void for_each_in_cell(const cell_t& cell, Fn&& fn) const
+    {
+        if (_positions.empty())
+            return;
+        const uint32_t bucket = _bucket(cell);
+
+        for (uint32_t k = _starts[bucket]; k < _starts[bucket + 1]; k++)
+        {
+            // other cells may share the bucket
+            if (_cells[k] == cell)
+                fn(_positions[k], _values[k]);
+        }
+    }
+
+    /// @brief Calls `fn(position, value, distance2)` for each point within a radius of a position
+    /// @details Visits the cells overlapping the sphere, bucket by bucket
+    template<class Fn>
+    void for_each_in_radius(const vector_t& center, const Scalar radius, Fn&& fn) const
+    {
+        if (_positions.empty())
+            return;
+
+        const Scalar radius2 = radius * radius;
+        const cell_t lo = cell_of(center - radius);
+        const cell_t hi = cell_of(center + radius);
+        cell_t cell = lo;
+
+        // odometer over the cells of the box [lo, hi]
+        while (true)
+        {
+            const uint32_t bucket = _bucket(cell);
+
+            for (uint32_t k = _starts[bucket]; k < _starts[bucket + 1]; k++)
+            {
+                const Scalar distance2 = _positions[k].distance2(center);
+
+                if (distance2 <= radius2 && _cells[k] == cell)
+                    fn(_positions[k], _values[k], distance2);
+            }
+
+            size_t c = 0;
+
+            for (; c < Size && cell[c] == hi[c]; c++)
+                cell[c] = lo[c];
+            if (c == Size)
+                return;
+            cell[c]++;
+        }
+    }
+
+    /// @brief Appends the values of the points within a radius of a position to `out`
+    void find_in_radius(const vector_t& center, const Scalar radius, std::vector<T>& out) const
+    {
+        for_each_in_radius(center, radius, [&](const vector_t&, const T& value, Scalar) { out.push_back(value); });
+    }
+
+    /// @brief Gets the number of points
+    size_t size() const noexcept
+    {
+        return _positions.size();
+    }
+
+    /// @brief Gets the edge length of the cells
+    Scalar cell_size() const noexcept
+    {
+        return _cell_size;
+    }
+
+    /// @brief Gets the number of buckets of the hash table
+    /// @details A power of two at least as large as the number of points
+    size_t bucket_count() const noexcept
+    {
+        return _starts.empty() ? 0 : _starts.size() - 1;
+    }
+
+    /// @brief Gets the positions in storage order, sorted by bucket
+    const vector_t* positions() const noexcept
+    {
+        return _positions.data();
+    }
+
+    /// @brief Gets the values in storage order, sorted by bucket
+    const T* values() const noexcept
+    {
+        return _values.data();
+    }
+
+private:
+    using _index_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<uint32_t>;
+    using _vector_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<vector_t>;
+    using _cell_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<cell_t>;
+
+    uint32_t _bucket(const cell_t& cell) const noexcept
+    {
+        uint32_t hash = 0;
+
+        for (size_t c = 0; c < Size; c++)
+        {
+            hash = (hash + uint32_t(cell[c])) * 0x9E3779B1u;
+            hash ^= hash >> 15;
+        }
+        return hash & uint32_t(_starts.size() - 2);
+    }
+
+    // stable counting sort by bucket: each thread counts the buckets of a contiguous range of points,
+    // the counts are turned into offsets bucket by bucket and thread by thread, and each thread then
+    // scatters its range to its offsets
+    template<class Value_fn>
+    void _build(const vector_t* positions, const size_t count, const size_t threads, const Value_fn& value)
+    {
+        size_t buckets = 1;
+
+        while (buckets < count)
+            buckets *= 2;
+
+        const size_t workers = std::max<size_t>(std::min(threads ? threads : default_thread_count(), count / _min_grain), 1);
+        const size_t grain = (count + workers - 1) / workers;
+
+        _starts.assign(buckets + 1, 0);
+        _counts.assign(workers * buckets, 0);
+        _buckets.resize(count);
+        _positions.resize(count);
+        _cells.resize(count);
+        _values.resize(count);
+
+        parallel_for(count, grain, workers, [&](const size_t first, const size_t last, size_t)
+        {
+            uint32_t* counts = &_counts[first / grain * buckets];
+
+            for (size_t i = first; i < last; i++)
+            {
+                _buckets[i] = _bucket(cell_of(positions[i]));
+                counts[_buckets[i]]++;
+            }
+        });
+
+        // the offsets are computed over ranges of buckets in parallel: first the total of each range,
+        // then the offsets within the ranges starting from the prefix of the totals
+        const size_t range = (buckets + workers - 1) / workers;
+        std::vector<size_t> totals(workers + 1);
+
+        parallel_for(buckets, range, workers, [&](const size_t first, const size_t last, size_t)
+        {
+            size_t total = 0;
+
+            for (size_t b = first; b < last; b++)
+            {
+                for (size_t t = 0; t < workers; t++)
+                    total += _counts[t * buckets + b];
+            }
+            totals[first / range + 1] = total;
+        });
+        for (size_t t = 0; t < workers; t++)
+            totals[t + 1] += totals[t];
+
+        parallel_for(buckets, range, workers, [&](const size_t first, const size_t last, size_t)
+        {
+            size_t offset = totals[first / range];
+
+            for (size_t b = first; b < last; b++)
+            {
+                _starts[b] = uint32_t(offset);
+
+                for (size_t t = 0; t < workers; t++)
+                {
+                    const uint32_t bucket_count = _counts[t * buckets + b];
+
+                    _counts[t * buckets + b] = uint32_t(offset);
+                    offset += bucket_count;
+                }
+            }
+        });
+        _starts[buckets] = uint32_t(count);
+
+        parallel_for(count, grain, workers, [&](const size_t first, const size_t last, size_t)
+        {
+            uint32_t* offsets = &_counts[first / grain * buckets];
+
+            for (size_t i = first; i < last; i++)
+            {
+                const uint32_t k = offsets[_buckets[i]]++;
+
+                _positions[k] = positions[i];
+                _cells[k] = cell_of(positions[i]);
+                _values[k] = value(i);
+            }
+        });
+    }
+
+    // the least number of points sorted by each thread
+    static constexpr size_t _min_grain = 4096;
+
+    Scalar _cell_size;
+    Scalar _inverse_cell_size;
+
+    // the first point of each bucket, followed by the number of points
+    std::vector<uint32_t, _index_allocator_t> _starts;
+
+    // the counts and then the offsets of each bucket, per thread
+    std::vector<uint32_t, _index_allocator_t> _counts;
+
+    // the bucket of each point in the order given, while building
+    std::vector<uint32_t, _index_allocator_t> _buckets;
+
+    std::vector<vector_t, _vector_allocator_t> _positions;
+    std::vector<cell_t, _cell_allocator_t> _cells;
+    std::vector<T, Allocator> _values;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,798 @@
+#pragma once
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+namespace impl
+{
+    // the relative error bounds of the orientation determinants evaluated in double precision,
+    // from Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates"
+    inline constexpr double _epsilon = 0x1.0p-53;
+    inline constexpr double _orient2d_bound = (3 + 16 * _epsilon) * _epsilon;
+    inline constexpr double _orient3d_bound = (7 + 56 * _epsilon) * _epsilon;
+
+    // x + y == a + b exactly
+    inline void _two_sum(const double a, const double b, double& x, double& y) noexcept
+    {
+        x = a + b;
+        const double b_virtual = x - a;
+        const double a_virtual = x - b_virtual;
+        y = (a - a_virtual) + (b - b_virtual);
+    }
+
+    // x + y == a * b exactly
+    inline void _two_product(const double a, const double b, double& x, double& y) noexcept
+    {
+        x = a * b;
+        y = std::fma(a, b, -x);
+    }
+
+    // a sum of doubles represented exactly, as non-overlapping terms of increasing magnitude
+    template<size_t Capacity>
+    struct _expansion
+    {
+        void add(double value) noexcept
+        {
+            size_t kept = 0;
+
+            for (size_t i = 0; i < size; i++)
+            {
+                double low;
+                _two_sum(value, terms[i], value, low);
+
+                if (low != 0)
+                    terms[kept++] = low;
+            }
+            if (value != 0)
+                terms[kept++] = value;
+            size = kept;
+        }
+
+        // adds the product of 2-term expansions, negated if `negate`
+        void add_product(const double* a, const double* b, const bool negate) noexcept
+        {
+            for (size_t i = 0; i < 2; i++)
+            {
+                for (size_t j = 0; j < 2; j++)
+                {
+                    double high, low;
+                    _two_product(a[i], b[j], high, low);
+                    add(negate ? -high : high);
+                    add(negate ? -low : low);
+                }
+            }
+        }
+
+        // adds the product of three 2-term expansions, negated if `negate`
+        void add_product(const double* a, const double* b, const double* c, const bool negate) noexcept
+        {
+            for (size_t i = 0; i < 2; i++)
+            {
+                for (size_t j = 0; j < 2; j++)
+                {
+                    double ab[2];
+                    _two_product(a[i], b[j], ab[0], ab[1]);
+
+                    for (size_t k = 0; k < 2; k++)
+                    {
+                        for (const double factor : ab)
+                        {
+                            double high, low;
+                            _two_product(factor, c[k], high, low);
+                            add(negate ? -high : high);
+                            add(negate ? -low : low);
+                        }
+                    }
+                }
+            }
+        }
+
+        int sign() const noexcept
+        {
+            return size == 0 ? 0 : terms[size - 1] > 0 ? 1 : -1;
+        }
+
+        double terms[Capacity];
+        size_t size = 0;
+    };
+
+    // the difference b - a as a 2-term expansion
+    inline void _two_difference(const double b, const double a, double* out) noexcept
+    {
+        _two_sum(b, -a, out[1], out[0]);
+    }
+
+    inline int _sign(const double value) noexcept
+    {
+        return (value > 0) - (value < 0);
+    }
+}
+
+/// @brief Gets the orientation of three points in the plane
+/// @details Exact for any finite input: the determinant is evaluated in double precision and, only
+///          when its rounding error bound does not settle the sign, again with exact arithmetic
+/// @return 1 if `c` is to the left of the line from `a` to `b` (counterclockwise), -1 if to the
+///         right, 0 if the points are collinear: the sign of `(b - a) x (c - a)`
+template<class Scalar>
+inline int orient2d(const vector<Scalar, 2>& a, const vector<Scalar, 2>& b, const vector<Scalar, 2>& c) noexcept
+{
+    static_assert(std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>, "Predicates are defined for float and double");
+
+    const double2d pa = a.template scalar_cast<double>();
+    const double2d u = b.template scalar_cast<double>() - pa, v = c.template scalar_cast<double>() - pa;
+    const double left = u.x * v.y, right = u.y * v.x;
+    const double det = left - right;
+
+    if (std::abs(det) > impl::_orient2d_bound * (std::abs(left) + std::abs(right)))
+        return impl::_sign(det);
+
+    double ux[2], uy[2], vx[2], vy[2];
+    impl::_two_difference(b.x, a.x, ux);
+    impl::_two_difference(b.y, a.y, uy);
+    impl::_two_difference(c.x, a.x, vx);
+    impl::_two_difference(c.y, a.y, vy);
+
+    impl::_expansion<17> exact;
+    exact.add_product(ux, vy, false);
+    exact.add_product(uy, vx, true);
+    return exact.sign();
+}
+
+/// @brief Gets the orientation of four points in space
+/// @details Exact for any finite input, as `orient2d`
+/// @return 1 if `d` is on the side of the plane through `a`, `b` and `c` which they turn
+///         counterclockwise around, -1 if on the other side, 0 if the points are coplanar: the
+///         sign of `((b - a) x (c - a)) . (d - a)`
+template<class Scalar>
+inline int orient3d(const vector<Scalar, 3>& a, const vector<Scalar, 3>& b, const vector<Scalar, 3>& c, const vector<Scalar, 3>& d) noexcept
+{
+    static_assert(std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>, "Predicates are defined for float and double");
+
+    const double3d pa = a.template scalar_cast<double>();
+    const double3d u = b.template scalar_cast<double>() - pa, v = c.template scalar_cast<double>() - pa, w = d.template scalar_cast<double>() - pa;
+    const double det = u.cross(v).dot(w);
+    const double permanent = (std::abs(u.y * v.z) + std::abs(u.z * v.y)) * std::abs(w.x) + (std::abs(u.z * v.x) + std::abs(u.x * v.z)) * std::abs(w.y) +
+                             (std::abs(u.x * v.y) + std::abs(u.y * v.x)) * std::abs(w.z);
+
+    if (std::abs(det) > impl::_orient3d_bound * permanent)
+        return impl::_sign(det);
+
+    double e[3][3][2];
+
+    for (size_t k = 0; k < 3; k++)
+    {
+        impl::_two_difference(b[k], a[k], e[0][k]);
+        impl::_two_difference(c[k], a[k], e[1][k]);
+        impl::_two_difference(d[k], a[k], e[2][k]);
+    }
+
+    // the determinant of the rows u, v, w
+    impl::_expansion<193> exact;
+    exact.add_product(e[0][1], e[1][2], e[2][0], false);
+    exact.add_product(e[0][2], e[1][1], e[2][0], true);
+    exact.add_product(e[0][2], e[1][0], e[2][1], false);
+    exact.add_product(e[0][0], e[1][2], e[2][1], true);
+    exact.add_product(e[0][0], e[1][1], e[2][2], false);
+    exact.add_product(e[0][1], e[1][0], e[2][2], true);
+    return exact.sign();
+}
+
+namespace impl
+{
+    // the number of points tested at once by a thread when discarding interior points
+    inline constexpr size_t _hull_grain = 16384;
+
+    // the indices of the points farthest along each direction, then of those farthest against each,
+    // the first of ties. Both ends of a direction come from one pass over the points
+    template<class Scalar, size_t Size>
+    inline std::vector<uint32_t> _hull_extremes(const vector<Scalar, Size>* points, const size_t count, const std::vector<vector<Scalar, Size>>& directions,
+                                                const size_t threads)
+    {
+        const size_t chunks = (count + _hull_grain - 1) / _hull_grain, extremes = 2 * directions.size();
+        std::vector<uint32_t> best(chunks * extremes);
+
+        parallel_for(count, _hull_grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            uint32_t* out = &best[first / _hull_grain * extremes];
+
+            for (size_t k = 0; k < directions.size(); k++)
+            {
+                const vector<Scalar, Size> direction = directions[k];
+                Scalar lo = points[first].dot(direction), hi = lo;
+                uint32_t lo_index = uint32_t(first), hi_index = uint32_t(first);
+
+                for (size_t i = first + 1; i < last; i++)
+                {
+                    const Scalar distance = points[i].dot(direction);
+
+                    if (distance > hi)
+                    {
+                        hi = distance;
+                        hi_index = uint32_t(i);
+                    }
+                    if (distance < lo)
+                    {
+                        lo = distance;
+                        lo_index = uint32_t(i);
+                    }
+                }
+                out[k] = hi_index;
+                out[directions.size() + k] = lo_index;
+            }
+        });
+
+        std::vector<uint32_t> out(best.begin(), best.begin() + extremes);
+
+        for (size_t chunk = 1; chunk < chunks; chunk++)
+        {
+            for (size_t k = 0; k < directions.size(); k++)
+            {
+                const uint32_t hi = best[chunk * extremes + k], lo = best[chunk * extremes + directions.size() + k];
+
+                if (points[hi].dot(directions[k]) > points[out[k]].dot(directions[k]))
+                    out[k] = hi;
+                if (points[lo].dot(directions[k]) < points[out[directions.size() + k]].dot(directions[k]))
+                    out[directions.size() + k] = lo;
+            }
+        }
+        return out;
+    }
+
+    // an edge of a counterclockwise polygon, with the rounding error bound of `orient2d` for any
+    // point in the bounding box of extent `extent`
+    struct _hull_edge
+    {
+        double2d origin, direction;
+        double bound;
+
+        _hull_edge(const double2d& a, const double2d& b, const double2d& extent) : origin(a), direction(b - a)
+        {
+            bound = 2 * _orient2d_bound * (std::abs(direction.x) * extent.y + std::abs(direction.y) * extent.x);
+        }
+
+        // true only where `orient2d` is 1, evaluated as it does
+        bool left(const double2d& p) const noexcept
+        {
+            const double2d w = p - origin;
+            return direction.x * w.y - direction.y * w.x > bound;
+        }
+    };
+
+    // a face of a polytope, as `_hull_edge`
+    struct _hull_plane
+    {
+        double3d origin, normal;
+        double bound;
+
+        _hull_plane(const double3d& a, const double3d& b, const double3d& c, const double3d& extent) : origin(a)
+        {
+            const double3d u = b - a, v = c - a;
+            const double3d permanent(std::abs(u.y * v.z) + std::abs(u.z * v.y), std::abs(u.z * v.x) + std::abs(u.x * v.z), std::abs(u.x * v.y) + std::abs(u.y * v.x));
+
+            normal = u.cross(v);
+            bound = 2 * _orient3d_bound * permanent.dot(extent);
+        }
+
+        // the sign of `orient3d` where the rounding error cannot change it, else 0
+        int side(const double3d& p) const noexcept
+        {
+            const double det = normal.dot(p - origin);
+            return (det > bound) - (det < -bound);
+        }
+    };
+
+    // the extent of the bounding box of some points
+    template<class Scalar, size_t Size>
+    inline vector<double, Size> _hull_extent(const vector<Scalar, Size>* points, const std::vector<uint32_t>& indices)
+    {
+        vector<double, Size> lo = points[indices[0]].template scalar_cast<double>(), hi = lo;
+
+        for (const uint32_t i : indices)
+        {
+            lo = lo.min(points[i].template scalar_cast<double>());
+            hi = hi.max(points[i].template scalar_cast<double>());
+        }
+        return hi - lo;
+    }
+
+    // the indices of the points not strictly inside a convex polytope, in order. `inside(p)` tells
+    // whether a point is strictly inside
+    template<class Vector, class Inside>
+    inline std::vector<uint32_t> _hull_candidates(const Vector* points, const size_t count, const size_t threads, const Inside& inside)
+    {
+        const size_t chunks = (count + _hull_grain - 1) / _hull_grain;
+        std::vector<std::vector<uint32_t>> kept(chunks);
+
+        parallel_for(count, _hull_grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            std::vector<uint32_t>& out = kept[first / _hull_grain];
+
+            for (size_t i = first; i < last; i++)
+            {
+                if (!inside(points[i]))
+                    out.push_back(uint32_t(i));
+            }
+        });
+
+        std::vector<uint32_t> out;
+
+        for (const std::vector<uint32_t>& chunk : kept)
+            out.insert(out.end(), chunk.begin(), chunk.end());
+        return out;
+    }
+
+    // Andrew's monotone chain over a subset of the points
+    template<class Scalar>
+    inline void _monotone_chain(const vector<Scalar, 2>* points, std::vector<uint32_t>& indices, std::vector<uint32_t>& out)
+    {
+        std::sort(indices.begin(), indices.end(), [&](const uint32_t i, const uint32_t j)
+        {
+            return points[i].x < points[j].x || (points[i].x == points[j].x && (points[i].y < points[j].y || (points[i].y == points[j].y && i < j)));
+        });
+        indices.erase(std::unique(indices.begin(), indices.end(), [&](const uint32_t i, const uint32_t j) { return points[i] == points[j]; }), indices.end());
+
+        out.clear();
+
+        if (indices.size() < 3)
+        {
+            out = indices;
+            return;
+        }
+
+        // the lower chain from left to right, then the upper chain back, keeping strict left turns
+        out.resize(2 * indices.size());
+        size_t k = 0;
+
+        for (size_t n = 0; n < indices.size(); n++)
+        {
+            while (k >= 2 && orient2d(points[out[k - 2]], points[out[k - 1]], points[indices[n]]) <= 0)
+                k--;
+            out[k++] = indices[n];
+        }
+        for (size_t n = indices.size() - 1, lower = k + 1; n-- > 0;)
+        {
+            while (k >= lower && orient2d(points[out[k - 2]], points[out[k - 1]], points[indices[n]]) <= 0)
+                k--;
+            out[k++] = indices[n];
+        }
+
+        // the first point closes the upper chain
+        out.resize(k - 1);
+    }
+
+    // quickhull: starting from a tetrahedron, repeatedly adds the farthest point outside a face,
+    // replacing the faces it sees by a cone from their horizon to it
+    template<class Scalar>
+    class _quickhull
+    {
+    public:
+        using vector_t = vector<Scalar, 3>;
+
+        _quickhull(const vector_t* points) : _points(points) {}
+
+        void run(const std::vector<uint32_t>& candidates, std::vector<std::array<uint32_t, 3>>& out)
+        {
+            out.clear();
+
+            if (candidates.size() < 4)
+                return;
+
+            _extent = _hull_extent(_points, candidates);
+
+            if (!_seed(candidates))
+                return;
+
+            // each candidate goes to the outside set of the first face it is strictly in front of
+            for (const uint32_t i : candidates)
+                _assign(i, 0, _faces.size());
+
+            for (size_t f = 0; f < _faces.size(); f++)
+            {
+                // new faces are appended, so this visits them too
+                while (!_faces[f].deleted && !_faces[f].outside.empty())
+                    _add(f);
+            }
+
+            for (const _face& face : _faces)
+            {
+                if (!face.deleted)
+                    out.push_back(face.vertices);
+            }
+        }
+
+    private:
+        struct _face
+        {
+            std::array<uint32_t, 3> vertices;
+            _hull_plane plane;
+            std::vector<uint32_t> outside;
+            bool deleted = false;
+            bool visible = false;
+        };
+
+        static uint64_t _edge(const uint32_t from, const uint32_t to) noexcept
+        {
+            return uint64_t(from) << 32 | to;
+        }
+
+        _face _make_face(const uint32_t a, const uint32_t b, const uint32_t c) const
+        {
+            const _hull_plane plane(_points[a].template scalar_cast<double>(), _points[b].template scalar_cast<double>(),
+                                    _points[c].template scalar_cast<double>(), _extent);
+            return { { a, b, c }, plane, {} };
+        }
+
+        // the plane of the face settles most orientations without recomputing its normal
+        int _orient(const _face& face, const uint32_t i) const noexcept
+        {
+            const int side = face.plane.side(_points[i].template scalar_cast<double>());
+            return side != 0 ? side : orient3d(_points[face.vertices[0]], _points[face.vertices[1]], _points[face.vertices[2]], _points[i]);
+        }
+
+        // the distance of a point in front of a face, scaled by the area of the face
+        static double _height(const _face& face, const double3d& p) noexcept
+        {
+            return face.plane.normal.dot(p - face.plane.origin);
+        }
+
+        void _add_face(const uint32_t a, const uint32_t b, const uint32_t c)
+        {
+            const uint32_t f = uint32_t(_faces.size());
+
+            _faces.push_back(_make_face(a, b, c));
+            _edges[_edge(a, b)] = f;
+            _edges[_edge(b, c)] = f;
+            _edges[_edge(c, a)] = f;
+        }
+
+        // puts a point in the outside set of the first face of [first, last) it is in front of
+        void _assign(const uint32_t i, const size_t first, const size_t last)
+        {
+            for (size_t f = first; f < last; f++)
+            {
+                if (!_faces[f].deleted && _orient(_faces[f], i) > 0)
+                {
+                    _faces[f].outside.push_back(i);
+                    return;
+                }
+            }
+        }
+
+        // the initial tetrahedron of extreme points, with its faces turning outwards
+        bool _seed(const std::vector<uint32_t>& candidates)
+        {
+
+            // the farthest apart of the extremes along the axes
+            uint32_t extremes[6];
+
+            for (size_t k = 0; k < 6; k++)
+                extremes[k] = candidates[0];
+            for (const uint32_t i : candidates)
+            {
+                for (size_t k = 0; k < 3; k++)
+                {
+                    if (_points[i][k] < _points[extremes[2 * k]][k])
+                        extremes[2 * k] = i;
+                    if (_points[i][k] > _points[extremes[2 * k + 1]][k])
+                        extremes[2 * k + 1] = i;
+                }
+            }
+
+            uint32_t a = extremes[0], b = extremes[1];
+            double farthest = -1;
+
+            for (const uint32_t i : extremes)
+            {
+                for (const uint32_t j : extremes)
+                {
+                    const double distance2 = _points[i].template scalar_cast<double>().distance2(_points[j].template scalar_cast<double>());
+
+                    if (distance2 > farthest)
+                    {
+                        farthest = distance2;
+                        a = i;
+                        b = j;
+                    }
+                }
+            }
+            if (_points[a] == _points[b])
+                return false;
+
+            // the farthest from the line, then from the plane
+            const double3d pa = _points[a].template scalar_cast<double>(), ab = _points[b].template scalar_cast<double>() - pa;
+            uint32_t c = a, d = a;
+            farthest = 0;
+
+            for (const uint32_t i : candidates)
+            {
+                const double distance2 = ab.cross(_points[i].template scalar_cast<double>() - pa).length2();
+
+                if (distance2 > farthest)
+                {
+                    farthest = distance2;
+                    c = i;
+                }
+            }
+            if (c == a)
+                return false;
+
+            const _face base = _make_face(a, b, c);
+            farthest = 0;
+
+            for (const uint32_t i : candidates)
+            {
+                const double height = std::abs(_height(base, _points[i].template scalar_cast<double>()));
+
+                if (height > farthest && _orient(base, i) != 0)
+                {
+                    farthest = height;
+                    d = i;
+                }
+            }
+            if (d == a)
+            {
+                // rounding may hide a point off the plane behind larger coplanar ones
+                for (const uint32_t i : candidates)
+                {
+                    if (_orient(base, i) != 0)
+                        d = i;
+                }
+                if (d == a)
+                    return false;
+            }
+
+            // d behind the base
+            if (_orient(base, d) > 0)
+                std::swap(a, b);
+
+            _add_face(a, b, c);
+            _add_face(a, d, b);
+            _add_face(b, d, c);
+            _add_face(c, d, a);
+            return true;
+        }
+
+        // adds the farthest point in front of a face to the hull
+        void _add(const size_t start)
+        {
+            std::vector<uint32_t>& outside = _faces[start].outside;
+            uint32_t apex = outside[0];
+            double farthest = _height(_faces[start], _points[apex].template scalar_cast<double>());
+
+            for (const uint32_t i : outside)
+            {
+                const double height = _height(_faces[start], _points[i].template scalar_cast<double>());
+
+                if (height > farthest)
+                {
+                    farthest = height;
+                    apex = i;
+                }
+            }
+
+            // the faces the point is in front of, which form a connected region
+            std::vector<size_t> visible = { start }, stack = { start };
+            _faces[start].visible = true;
+
+            while (!stack.empty())
+            {
+                const _face& face = _faces[stack.back()];
+                stack.pop_back();
+
+                for (size_t k = 0; k < 3; k++)
+                {
+                    const size_t neighbour = _edges.at(_edge(face.vertices[(k + 1) % 3], face.vertices[k]));
+
+                    if (!_faces[neighbour].visible && _orient(_faces[neighbour], apex) > 0)
+                    {
+                        _faces[neighbour].visible = true;
+                        visible.push_back(neighbour);
+                        stack.push_back(neighbour);
+                    }
+                }
+            }
+
+            // the edges between visible faces and the others form the horizon, which the new faces
+            // join to the point
+            std::vector<std::array<uint32_t, 2>> horizon;
+
+            for (const size_t f : visible)
+            {
+                for (size_t k = 0; k < 3; k++)
+                {
+                    const uint32_t from = _faces[f].vertices[k], to = _faces[f].vertices[(k + 1) % 3];
+
+                    if (!_faces[_edges.at(_edge(to, from))].visible)
+                        horizon.push_back({ from, to });
+                }
+            }
+
+            std::vector<uint32_t> orphans;
+
+            for (const size_t f : visible)
+            {
+                _face& face = _faces[f];
+
+                for (size_t k = 0; k < 3; k++)
+                    _edges.erase(_edge(face.vertices[k], face.vertices[(k + 1) % 3]));
+
+                for (const uint32_t i : face.outside)
+                {
+                    if (i != apex)
+                        orphans.push_back(i);
+                }
+                face.outside = {};
+                face.deleted = true;
+            }
+
+            const size_t first = _faces.size();
+
+            for (const auto& [from, to] : horizon)
+                _add_face(from, to, apex);
+
+            // points in front of none of the new faces are inside the hull
+            for (const uint32_t i : orphans)
+                _assign(i, first, _faces.size());
+        }
+
+        const vector_t* _points;
+        double3d _extent;
+        std::vector<_face> _faces;
+        std::unordered_map<uint64_t, size_t> _edges;
+    };
+}
+
+/// @brief Finds the convex hull of points in the plane
+/// @details Points strictly inside the polygon of the extreme points along the axes and diagonals are
+///          first discarded in parallel, then Andrew's monotone chain builds the hull of the others.
+///          Orientations are decided by `orient2d`, so the result is exact even for nearly collinear
+///          points
+/// @param out Receives the indices of the vertices of the hull in counterclockwise order, starting
+///            from the one with the smallest x (and y). Points on edges and duplicates are left out.
+///            Fewer than 3 indices when the points are collinear
+/// @param count The number of points, less than 2^32
+/// @param threads The number of threads discarding interior points, 0 for `default_thread_count()`
+template<class Scalar>
+inline void convex_hull(const vector<Scalar, 2>* points, const size_t count, std::vector<uint32_t>& out, const size_t threads = 1)
+{
+    out.clear();
+
+    if (count == 0)
+        return;
+
+    // the extremes along the axes and diagonals, in counterclockwise order
+    using vector_t = vector<Scalar, 2>;
+    const std::vector<vector_t> directions = { { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 } };
+    std::vector<uint32_t> polygon;
+
+    for (const uint32_t i : impl::_hull_extremes(points, count, directions, threads))
+    {
+        if (polygon.empty() || (points[i] != points[polygon.back()] && points[i] != points[polygon.front()]))
+            polygon.push_back(i);
+    }
+
+    std::vector<impl::_hull_edge> edges;
+
+    if (polygon.size() >= 3)
+    {
+        // the extremes along the axes bound all the points, and so the rounding errors of the tests
+        const double2d extent = impl::_hull_extent(points, polygon);
+
+        for (size_t k = 0; k < polygon.size(); k++)
+            edges.emplace_back(points[polygon[k]].template scalar_cast<double>(), points[polygon[(k + 1) % polygon.size()]].template scalar_cast<double>(), extent);
+    }
+
+    std::vector<uint32_t> candidates = impl::_hull_candidates(points, count, threads, [&](const vector_t& p)
+    {
+        const double2d q = p.template scalar_cast<double>();
+
+        for (const impl::_hull_edge& edge : edges)
+        {
+            if (!edge.left(q))
+                return false;
+        }
+        return !edges.empty();
+    });
+
+    impl::_monotone_chain(points, candidates, out);
+}
+
+/// @brief Finds the convex hull of points in space
+/// @details Points strictly inside the hull of the extreme points along the axes and diagonals are
+///          first discarded in parallel, then quickhull builds the hull of the others. Orientations
+///          are decided by `orient3d`, so the result is consistent even for nearly coplanar points
+/// @param out Receives the triangles of the hull as indices of the points, counterclockwise seen
+///            from outside. Coplanar faces are triangulated and points inside faces are left out.
+///            Empty when the points are coplanar
+/// @param count The number of points, less than 2^32
+/// @param threads The number of threads discarding interior points, 0 for `default_thread_count()`
+template<class Scalar>
+inline void convex_hull(const vector<Scalar, 3>* points, const size_t count, std::vector<std::array<uint32_t, 3>>& out, const size_t threads = 1)
+{
+    out.clear();
+
+    if (count == 0)
+        return;
+
+    // the extremes along the axes and the diagonals of the cube
+    using vector_t = vector<Scalar, 3>;
+    std::vector<vector_t> directions;
+
+    for (int x = -1; x <= 1; x++)
+    {
+        for (int y = -1; y <= 1; y++)
+        {
+            for (int z = -1; z <= 1; z++)
+            {
+                // one of each opposite pair
+                if (x > 0 || (x == 0 && (y > 0 || (y == 0 && z > 0))))
+                    directions.emplace_back(Scalar(x), Scalar(y), Scalar(z));
+            }
+        }
+    }
+
+    std::vector<uint32_t> extremes = impl::_hull_extremes(points, count, directions, threads);
+    std::sort(extremes.begin(), extremes.end());
+    extremes.erase(std::unique(extremes.begin(), extremes.end()), extremes.end());
+
+    std::vector<std::array<uint32_t, 3>> polytope;
+    impl::_quickhull<Scalar>(points).run(extremes, polytope);
+
+    std::vector<impl::_hull_plane> planes;
+    double3d center;
+    double radius2 = -1;
+
+    if (!polytope.empty())
+    {
+        // as for the plane, a conservative test whose doubtful points are kept
+        const double3d extent = impl::_hull_extent(points, extremes);
+
+        for (const std::array<uint32_t, 3>& face : polytope)
+        {
+            planes.emplace_back(points[face[0]].template scalar_cast<double>(), points[face[1]].template scalar_cast<double>(),
+                                points[face[2]].template scalar_cast<double>(), extent);
+        }
+
+        // most interior points fall in a ball inside all the faces, and skip their tests. Its radius
+        // is shrunk by far more than the rounding errors of the distances
+        for (const uint32_t i : extremes)
+            center += points[i].template scalar_cast<double>();
+        center /= double(extremes.size());
+
+        double radius = std::numeric_limits<double>::infinity();
+
+        for (const impl::_hull_plane& plane : planes)
+            radius = std::min(radius, -plane.normal.dot(center - plane.origin) / plane.normal.length());
+        radius -= 0x1.0p-30 * extent.length();
+
+        if (radius > 0)
+            radius2 = radius * radius;
+    }
+
+    std::vector<uint32_t> candidates = impl::_hull_candidates(points, count, threads, [&](const vector_t& p)
+    {
+        const double3d q = p.template scalar_cast<double>();
+
+        if (q.distance2(center) < radius2)
+            return true;
+
+        for (const impl::_hull_plane& plane : planes)
+        {
+            if (plane.side(q) >= 0)
+                return false;
+        }
+        return !planes.empty();
+    });
+
+    impl::_quickhull<Scalar>(points).run(candidates, out);
+}
+
+
+_DD_NAMESPACE_CLOSE
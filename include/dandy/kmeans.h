@@ -0,0 +1,382 @@
+#pragma once
+#include "parallel.h"
+#include "random.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief The parameters of `kmeans`
+struct kmeans_options
+{
+    /// @brief The maximum number of iterations after seeding
+    size_t max_iterations = 100;
+
+    /// @brief Stops once no centroid moves further than this in an iteration
+    double tolerance = 0;
+
+    /// @brief The seed of the k-means++ seeding
+    uint64_t seed = 0;
+
+    /// @brief The number of threads, 0 for `default_thread_count()`
+    size_t threads = 1;
+};
+
+/// @brief The clustering found by `kmeans`
+template<class Scalar, size_t Size>
+struct kmeans_result
+{
+    /// @brief The centers of the clusters
+    std::vector<vector<Scalar, Size>> centroids;
+
+    /// @brief The index of the cluster of each point
+    std::vector<uint32_t> labels;
+
+    /// @brief The sum of the squared distances from the points to the centers of their clusters
+    double inertia = 0;
+
+    /// @brief The number of iterations run after seeding
+    size_t iterations = 0;
+
+    /// @brief Whether the clustering converged before `max_iterations`
+    bool converged = false;
+};
+
+namespace impl
+{
+    template<class Scalar, size_t Size>
+    struct _array_points
+    {
+        const vector<Scalar, Size>& operator[](const size_t i) const noexcept
+        {
+            return data[i];
+        }
+
+        const vector<Scalar, Size>* data;
+    };
+
+    template<class Scalar, size_t Size>
+    struct _component_points
+    {
+        vector<Scalar, Size> operator[](const size_t i) const noexcept
+        {
+            vector<Scalar, Size> out;
+
+            for (size_t c = 0; c < Size; c++)
+                out[c] = components[c][i];
+            return out;
+        }
+
+        std::array<const Scalar*, Size> components;
+    };
+
+    // Lloyd's algorithm with Hamerly's bounds: each point keeps an upper bound on the distance to its
+    // centroid and a lower bound on the distance to any other, and is only compared with all
+    // centroids when the bounds no longer prove its assignment.
+    //
+    // The points are processed in chunks whose boundaries depend only on the number of points. Sums
+    // are accumulated per chunk and merged in chunk order, so the results are identical for any
+    // number of threads
+    template<class Scalar, size_t Size, class Points>
+    class _kmeans
+    {
+    public:
+        using vector_t = vector<Scalar, Size>;
+        using sum_t = vector<double, Size>;
+
+        static_assert(std::is_floating_point_v<Scalar>, "K-means has to be of a floating point type");
+
+        _kmeans(const Points& points, const size_t count, const size_t k, const kmeans_options& options)
+            : _points(points), _count(count), _k(std::min(k, count)), _options(options),
+              _grain(std::max(_min_grain, (count + _max_chunks - 1) / _max_chunks)), _chunks((count + _grain - 1) / _grain)
+        {}
+
+        kmeans_result<Scalar, Size> run()
+        {
+            kmeans_result<Scalar, Size> out;
+
+            if (_k == 0)
+                return out;
+
+            _upper.resize(_count);
+            _lower.assign(_count, Scalar(0));
+            _chunk_values.resize(_chunks);
+            _movement.assign(_k, Scalar(0));
+            _seed(out.centroids);
+
+            // the first assignment compares every point with all centroids
+            out.labels.assign(_count, 0);
+            std::fill(_upper.begin(), _upper.end(), std::numeric_limits<Scalar>::infinity());
+            _assign(out.centroids, out.labels);
+
+            while (out.iterations < _options.max_iterations)
+            {
+                out.iterations++;
+
+                if (_update(out.centroids, out.labels) <= _options.tolerance || _assign(out.centroids, out.labels) == 0)
+                {
+                    out.converged = true;
+                    break;
+                }
+            }
+            out.inertia = _inertia(out.centroids, out.labels);
+            return out;
+        }
+
+    private:
+        static constexpr size_t _min_grain = 4096;
+        static constexpr size_t _max_chunks = 256;
+
+        template<class Fn>
+        void _for_chunks(const Fn& fn) const
+        {
+            parallel_for(_count, _grain, _options.threads, [&](const size_t first, const size_t last, size_t) { fn(first / _grain, first, last); });
+        }
+
+        double _sum_chunks() const
+        {
+            double out = 0;
+
+            for (const double value : _chunk_values)
+                out += value;
+            return out;
+        }
+
+        // k-means++: each centroid is drawn with probability proportional to the squared distance to
+        // the nearest centroid drawn before it. The squared distances are kept in `_upper`
+        void _seed(std::vector<vector_t>& centroids)
+        {
+            xoshiro256 rng(_options.seed);
+
+            centroids.clear();
+            centroids.push_back(_points[size_t(_unit<double>(rng()) * double(_count))]);
+            std::fill(_upper.begin(), _upper.end(), std::numeric_limits<Scalar>::infinity());
+
+            while (centroids.size() < _k)
+            {
+                const vector_t latest = centroids.back();
+
+                _for_chunks([&](const size_t chunk, const size_t first, const size_t last)
+                {
+                    double sum = 0;
+
+                    for (size_t i = first; i < last; i++)
+                    {
+                        _upper[i] = std::min(_upper[i], _points[i].distance2(latest));
+                        sum += _upper[i];
+                    }
+                    _chunk_values[chunk] = sum;
+                });
+
+                const double total = _sum_chunks();
+                double target = _unit<double>(rng()) * total;
+                size_t chosen = size_t(_unit<double>(rng()) * double(_count));
+
+                // when all points coincide with centroids, any point will do
+                if (total > 0)
+                {
+                    size_t chunk = 0;
+
+                    for (; chunk + 1 < _chunks && target >= _chunk_values[chunk]; chunk++)
+                        target -= _chunk_values[chunk];
+
+                    const size_t last = std::min((chunk + 1) * _grain, _count);
+                    chosen = last - 1;
+
+                    for (size_t i = chunk * _grain; i < last; i++)
+                    {
+                        if (target < _upper[i])
+                        {
+                            chosen = i;
+                            break;
+                        }
+                        target -= _upper[i];
+                    }
+                }
+                centroids.push_back(_points[chosen]);
+            }
+        }
+
+        // assigns the points to their nearest centroids, returning the number of changed assignments
+        size_t _assign(const std::vector<vector_t>& centroids, std::vector<uint32_t>& labels)
+        {
+            // half the distance from each centroid to the nearest other: points closer than that to
+            // their centroid cannot be closer to another
+            std::vector<Scalar> half(_k, std::numeric_limits<Scalar>::infinity());
+
+            for (size_t a = 0; a < _k; a++)
+            {
+                for (size_t b = a + 1; b < _k; b++)
+                {
+                    const Scalar distance = Scalar(0.5) * std::sqrt(centroids[a].distance2(centroids[b]));
+
+                    half[a] = std::min(half[a], distance);
+                    half[b] = std::min(half[b], distance);
+                }
+            }
+
+            // the lower bounds shrink by the largest movement of any other centroid
+            size_t farthest = 0;
+            Scalar largest = 0, second = 0;
+
+            for (size_t j = 0; j < _k; j++)
+            {
+                if (_movement[j] > largest)
+                {
+                    second = largest;
+                    largest = _movement[j];
+                    farthest = j;
+                }
+                else
+                    second = std::max(second, _movement[j]);
+            }
+
+            _for_chunks([&](const size_t chunk, const size_t first, const size_t last)
+            {
+                size_t changed = 0;
+
+                for (size_t i = first; i < last; i++)
+                {
+                    const uint32_t label = labels[i];
+                    _upper[i] += _movement[label];
+                    _lower[i] -= label == farthest ? second : largest;
+                    const Scalar bound = std::max(half[label], _lower[i]);
+
+                    if (_upper[i] <= bound)
+                        continue;
+
+                    const vector_t& point = _points[i];
+                    _upper[i] = std::sqrt(point.distance2(centroids[label]));
+
+                    if (_upper[i] <= bound)
+                        continue;
+
+                    Scalar nearest = std::numeric_limits<Scalar>::infinity(), next = nearest;
+                    uint32_t best = 0;
+
+                    for (size_t j = 0; j < _k; j++)
+                    {
+                        const Scalar distance2 = point.distance2(centroids[j]);
+
+                        if (distance2 < nearest)
+                        {
+                            next = nearest;
+                            nearest = distance2;
+                            best = uint32_t(j);
+                        }
+                        else
+                            next = std::min(next, distance2);
+                    }
+                    changed += best != label;
+                    labels[i] = best;
+                    _upper[i] = std::sqrt(nearest);
+                    _lower[i] = std::sqrt(next);
+                }
+                _chunk_values[chunk] = double(changed);
+            });
+            return size_t(_sum_chunks());
+        }
+
+        // moves the centroids to the means of their points, returning the largest movement
+        Scalar _update(std::vector<vector_t>& centroids, const std::vector<uint32_t>& labels)
+        {
+            _chunk_sums.assign(_chunks * _k, sum_t());
+            _chunk_counts.assign(_chunks * _k, 0);
+
+            _for_chunks([&](const size_t chunk, const size_t first, const size_t last)
+            {
+                sum_t* sums = &_chunk_sums[chunk * _k];
+                size_t* counts = &_chunk_counts[chunk * _k];
+
+                for (size_t i = first; i < last; i++)
+                {
+                    sums[labels[i]] += _points[i];
+                    counts[labels[i]]++;
+                }
+            });
+
+            Scalar largest = 0;
+
+            for (size_t j = 0; j < _k; j++)
+            {
+                sum_t sum;
+                size_t count = 0;
+
+                for (size_t chunk = 0; chunk < _chunks; chunk++)
+                {
+                    sum += _chunk_sums[chunk * _k + j];
+                    count += _chunk_counts[chunk * _k + j];
+                }
+
+                // empty clusters keep their centroid
+                if (count == 0)
+                {
+                    _movement[j] = 0;
+                    continue;
+                }
+
+                vector_t mean;
+
+                for (size_t c = 0; c < Size; c++)
+                    mean[c] = Scalar(sum[c] / double(count));
+                _movement[j] = std::sqrt(mean.distance2(centroids[j]));
+                largest = std::max(largest, _movement[j]);
+                centroids[j] = mean;
+            }
+            return largest;
+        }
+
+        double _inertia(const std::vector<vector_t>& centroids, const std::vector<uint32_t>& labels)
+        {
+            _for_chunks([&](const size_t chunk, const size_t first, const size_t last)
+            {
+                double sum = 0;
+
+                for (size_t i = first; i < last; i++)
+                    sum += _points[i].distance2(centroids[labels[i]]);
+                _chunk_values[chunk] = sum;
+            });
+            return _sum_chunks();
+        }
+
+        Points _points;
+        size_t _count;
+        size_t _k;
+        kmeans_options _options;
+        size_t _grain;
+        size_t _chunks;
+
+        std::vector<Scalar> _upper, _lower, _movement;
+        std::vector<double> _chunk_values;
+        std::vector<sum_t> _chunk_sums;
+        std::vector<size_t> _chunk_counts;
+    };
+}
+
+/// @brief Partitions points into `k` clusters with k-means
+/// @details The centroids are seeded with k-means++ and refined with Lloyd's algorithm, skipping
+///          the distance computations which Hamerly's bounds prove unnecessary. The result is that
+///          of the plain algorithm up to rounding in near ties, and does not depend on `options.threads`.
+///
+///          Clusters which lose all their points keep their centroid
+/// @param k The number of clusters; fewer when there are fewer points
+template<class Scalar, size_t Size>
+inline kmeans_result<Scalar, Size> kmeans(const vector<Scalar, Size>* points, const size_t count, const size_t k, const kmeans_options& options = {})
+{
+    return impl::_kmeans<Scalar, Size, impl::_array_points<Scalar, Size>>({ points }, count, k, options).run();
+}
+
+/// @brief Partitions points stored as structure of arrays into `k` clusters with k-means
+/// @details Component `c` of point `i` is `components[c][i]`; otherwise the same as the overload
+///          taking an array of vectors
+template<class Scalar, size_t Size>
+inline kmeans_result<Scalar, Size> kmeans(const std::array<const Scalar*, Size>& components, const size_t count, const size_t k,
+                                          const kmeans_options& options = {})
+{
+    return impl::_kmeans<Scalar, Size, impl::_component_points<Scalar, Size>>({ components }, count, k, options).run();
+}
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,259 @@
+#pragma once
+#include "dandy.h"
+#include <new>     // std::align_val_t
+#include <cstddef> // std::max_align_t
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief Allocator returning memory aligned to `Align` bytes
+/// @details Suitable for standard containers, e.g. `std::vector<float4d, aligned_allocator<float4d>>`
+///          for aligned SIMD loads over the whole array
+/// @param T The allocated type
+/// @param Align The alignment in bytes; defaults to the size of a cache line
+template<class T, size_t Align = 64>
+struct aligned_allocator
+{
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Alignment must be a power of two not less than alignof(T)");
+
+    using value_type = T;
+
+    template<class U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Align>;
+    };
+
+    constexpr aligned_allocator() noexcept = default;
+
+    template<class U>
+    constexpr aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Align)));
+    }
+
+    void deallocate(T* const pointer, const size_t) noexcept
+    {
+        ::operator delete(pointer, std::align_val_t(Align));
+    }
+
+    template<class U>
+    constexpr bool operator==(const aligned_allocator<U, Align>&) const noexcept
+    {
+        return true;
+    }
+
+    template<class U>
+    constexpr bool operator!=(const aligned_allocator<U, Align>&) const noexcept
+    {
+        return false;
+    }
+};
+
+/// @brief Usage statistics of an `arena`
+struct arena_stats
+{
+    /// @brief Bytes handed out since the last reset and not yet reclaimed
+    /// @details Deallocations which are not reclaimed immediately (see `arena::deallocate`) keep
+    ///          counting until the reset, as their memory remains part of the frame
+    size_t bytes_in_use = 0;
+
+    /// @brief The largest value `bytes_in_use` has reached
+    size_t high_water_mark = 0;
+
+    /// @brief Allocations served since the last reset
+    size_t allocation_count = 0;
+
+    /// @brief Bytes currently held from the system
+    size_t bytes_reserved = 0;
+
+    /// @brief Times memory has been requested from the system
+    size_t system_allocations = 0;
+};
+
+/// @brief Bump allocator with frame-reset semantics
+/// @details Allocations are served by advancing a pointer into blocks of memory held by the arena.
+///          Individual deallocations are only reclaimed if they are the most recent allocation;
+///          everything else is reclaimed at once by `reset`. When a frame needed more than one
+///          block, `reset` replaces them with a single block large enough for the whole frame,
+///          so that a steady-state frame loop does not allocate from the system at all.
+///
+/// @note The arena is not thread-safe; use one arena per thread
+class arena
+{
+public:
+    /// @param block_size The minimum size of the blocks requested from the system
+    explicit arena(const size_t block_size = 64 * 1024) noexcept : _block_size(block_size) {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena()
+    {
+        release();
+    }
+
+    /// @brief Allocates `bytes` bytes aligned to `alignment`
+    void* allocate(const size_t bytes, const size_t alignment = alignof(std::max_align_t))
+    {
+        while (true)
+        {
+            if (_current)
+            {
+                const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_current->data());
+                const size_t offset = _align(base + _offset, alignment) - base;
+
+                if (offset + bytes <= _current->size)
+                {
+                    _offset = offset + bytes;
+                    _last = _current->data() + offset;
+
+                    _stats.bytes_in_use += bytes;
+                    _stats.high_water_mark = std::max(_stats.high_water_mark, _stats.bytes_in_use);
+                    _stats.allocation_count++;
+                    return _last;
+                }
+            }
+            _current = _current && _current->next ? _current->next : _push_block(bytes + alignment);
+            _offset = 0;
+        }
+    }
+
+    /// @brief Returns memory to the arena
+    /// @details Only the most recent allocation is reclaimed immediately; other memory is
+    ///          reclaimed by `reset`
+    void deallocate(void* const pointer, const size_t bytes) noexcept
+    {
+        if (pointer && pointer == _last)
+        {
+            _offset = static_cast<std::byte*>(pointer) - _current->data();
+            _last = nullptr;
+            _stats.bytes_in_use -= std::min(bytes, _stats.bytes_in_use);
+        }
+    }
+
+    /// @brief Reclaims all allocations at once
+    /// @details Memory previously handed out by the arena must not be used afterwards
+    void reset()
+    {
+        if (_first && _first->next)
+        {
+            // coalesce into one block which fits the whole frame
+            const size_t size = _stats.bytes_reserved;
+
+            release();
+            _push_block(size);
+        }
+        _current = _first;
+        _offset = 0;
+        _last = nullptr;
+        _stats.bytes_in_use = 0;
+        _stats.allocation_count = 0;
+    }
+
+    /// @brief Returns all memory to the system
+    void release() noexcept
+    {
+        while (_first)
+        {
+            block* const next = _first->next;
+            ::operator delete(_first, std::align_val_t(alignof(block)));
+            _first = next;
+        }
+        _current = nullptr;
+        _offset = 0;
+        _last = nullptr;
+        _stats.bytes_in_use = 0;
+        _stats.allocation_count = 0;
+        _stats.bytes_reserved = 0;
+    }
+
+    /// @brief Gets the usage statistics of the arena
+    const arena_stats& stats() const noexcept
+    {
+        return _stats;
+    }
+private:
+    struct alignas(std::max_align_t) block
+    {
+        block* next;
+        size_t size;
+
+        std::byte* data() noexcept
+        {
+            return reinterpret_cast<std::byte*>(this + 1);
+        }
+    };
+
+    static std::uintptr_t _align(const std::uintptr_t address, const size_t alignment) noexcept
+    {
+        return (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    }
+
+    block* _push_block(const size_t min_size)
+    {
+        const size_t size = std::max(min_size, _block_size);
+        void* const memory = ::operator new(sizeof(block) + size, std::align_val_t(alignof(block)));
+        block* const out = ::new(memory) block{ nullptr, size };
+
+        if (_current)
+            _current->next = out;
+        else
+            _first = out;
+
+        _stats.bytes_reserved += size;
+        _stats.system_allocations++;
+        return out;
+    }
+
+    const size_t _block_size;
+    block* _first = nullptr;
+    block* _current = nullptr;
+    size_t _offset = 0;
+    void* _last = nullptr;
+    arena_stats _stats;
+};
+
+/// @brief Allocator drawing from an `arena`
+/// @details Suitable for standard containers, e.g. `std::vector<float3d, arena_allocator<float3d>>`.
+///          The arena has to outlive all containers using it
+template<class T>
+struct arena_allocator
+{
+    using value_type = T;
+
+    arena_allocator(arena& source) noexcept : source(&source) {}
+
+    template<class U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : source(other.source) {}
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(source->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* const pointer, const size_t count) noexcept
+    {
+        source->deallocate(pointer, count * sizeof(T));
+    }
+
+    template<class U>
+    bool operator==(const arena_allocator<U>& other) const noexcept
+    {
+        return source == other.source;
+    }
+
+    template<class U>
+    bool operator!=(const arena_allocator<U>& other) const noexcept
+    {
+        return source != other.source;
+    }
+
+    /// @brief The arena allocations are drawn from
+    arena* source;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,132 @@
+#pragma once
+#include "parallel.h"
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+namespace impl
+{
+    // the number of columns computed together; the columns of a tile stay in the cache while all rows
+    // of a chunk pass over them
+    inline constexpr size_t _pairwise_tile = 256;
+
+    // the number of rows sharing each load of the columns
+    inline constexpr size_t _pairwise_rows = 4;
+
+    // the number of rows claimed at once by a thread
+    inline constexpr size_t _pairwise_grain = 64;
+
+    // the vector size from which distances are expanded as |a|^2 + |b|^2 - 2a.b. Smaller vectors take
+    // the differences directly, which costs about as much and does not lose precision to cancellation
+    inline constexpr size_t _pairwise_expansion_size = 16;
+
+    // computes a block of `Rows` rows by `width` columns. `columns` holds component `c` of column `j`
+    // at `columns[c * stride + j]`
+    template<size_t Rows, class Scalar, size_t Size>
+    inline void _pairwise_block(const vector<Scalar, Size>* rows, const Scalar* columns, const size_t stride, const Scalar* norms,
+                                const size_t width, Scalar* out, const size_t out_stride) noexcept
+    {
+        if constexpr(Size < _pairwise_expansion_size)
+        {
+            for (size_t r = 0; r < Rows; r++)
+            {
+                Scalar* row = out + r * out_stride;
+
+                for (size_t j = 0; j < width; j++)
+                {
+                    Scalar sum = 0;
+
+                    for (size_t c = 0; c < Size; c++)
+                    {
+                        const Scalar difference = rows[r][c] - columns[c * stride + j];
+                        sum += difference * difference;
+                    }
+                    row[j] = sum;
+                }
+            }
+        }
+        else
+        {
+            // the dot products accumulate one component at a time, over all columns of the tile
+            Scalar sums[Rows][_pairwise_tile];
+
+            for (size_t r = 0; r < Rows; r++)
+            {
+                for (size_t j = 0; j < width; j++)
+                    sums[r][j] = 0;
+            }
+            for (size_t c = 0; c < Size; c++)
+            {
+                const Scalar* column = columns + c * stride;
+
+                for (size_t r = 0; r < Rows; r++)
+                {
+                    const Scalar x = rows[r][c];
+
+                    for (size_t j = 0; j < width; j++)
+                        sums[r][j] += x * column[j];
+                }
+            }
+            for (size_t r = 0; r < Rows; r++)
+            {
+                const Scalar norm = rows[r].length2();
+
+                // rounding may leave coincident points slightly negative
+                for (size_t j = 0; j < width; j++)
+                    sums[r][j] = std::max(Scalar(0), norm + norms[j] - Scalar(2) * sums[r][j]);
+                std::copy(sums[r], sums[r] + width, out + r * out_stride);
+            }
+        }
+    }
+}
+
+/// @brief Computes the squared distances between all pairs of vectors of two sets
+/// @details Writes the squared distance between `a[i]` and `b[j]` to `out[i * b_count + j]`. The
+///          result is computed in tiles of rows and columns which stay in the cache, with the second
+///          set transposed to structure of arrays so that the inner loops compile to vector instructions.
+///
+///          Vectors of 16 or more components are compared as `|a|^2 + |b|^2 - 2a.b`, saving a
+///          subtraction per component at the cost of precision when the distances are much smaller
+///          than the norms; smaller vectors use the differences directly
+/// @param out A row-major buffer of `a_count * b_count` scalars
+/// @param threads The number of threads computing rows, 0 for `default_thread_count()`
+template<class Scalar, size_t Size>
+inline void pairwise_distance2(const vector<Scalar, Size>* a, const size_t a_count, const vector<Scalar, Size>* b, const size_t b_count,
+                               Scalar* out, const size_t threads = 1)
+{
+    // the second set as structure of arrays
+    const size_t stride = b_count;
+    std::vector<Scalar> columns(Size * stride), norms;
+
+    for (size_t j = 0; j < b_count; j++)
+    {
+        for (size_t c = 0; c < Size; c++)
+            columns[c * stride + j] = b[j][c];
+    }
+    if constexpr(Size >= impl::_pairwise_expansion_size)
+    {
+        norms.resize(b_count);
+
+        for (size_t j = 0; j < b_count; j++)
+            norms[j] = b[j].length2();
+    }
+
+    parallel_for(a_count, impl::_pairwise_grain, threads, [&](const size_t first, const size_t last, size_t)
+    {
+        for (size_t column = 0; column < b_count; column += impl::_pairwise_tile)
+        {
+            const size_t width = std::min(impl::_pairwise_tile, b_count - column);
+            const Scalar* tile_norms = norms.empty() ? nullptr : norms.data() + column;
+            size_t i = first;
+
+            for (; i + impl::_pairwise_rows <= last; i += impl::_pairwise_rows)
+                impl::_pairwise_block<impl::_pairwise_rows>(a + i, columns.data() + column, stride, tile_norms, width, out + i * b_count + column, b_count);
+            for (; i < last; i++)
+                impl::_pairwise_block<1>(a + i, columns.data() + column, stride, tile_norms, width, out + i * b_count + column, b_count);
+        }
+    });
+}
+
+
+_DD_NAMESPACE_CLOSE
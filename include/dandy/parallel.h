@@ -0,0 +1,145 @@
+#pragma once
+#include "dandy.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief Gets the number of threads used when 0 threads are requested
+/// @details One per hardware thread
+inline size_t default_thread_count() noexcept
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+namespace impl
+{
+    // the helper threads of `parallel_for`, started on first use and kept until the program exits,
+    // so that calls made every frame do not pay for creating and joining threads.
+    //
+    // A call queues one task per helper and works on its chunks itself. Once they are all claimed,
+    // it takes back the tasks no thread has started and waits only for the started ones, so calls
+    // from several threads, or nested in the function of another call, never wait on a busy pool
+    class _thread_pool
+    {
+    public:
+        ~_thread_pool()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _available.notify_all();
+
+            for (std::thread& thread : _threads)
+                thread.join();
+        }
+
+        // calls `work(thread)` with `thread` 0 on the calling thread and 1 to `helpers` on the pool
+        template<class Work>
+        void run(const size_t helpers, const Work& work)
+        {
+            size_t running = 0;
+            {
+                const std::lock_guard<std::mutex> lock(_mutex);
+
+                while (_threads.size() < helpers)
+                    _threads.emplace_back([this] { _work(); });
+                for (size_t t = 1; t <= helpers; t++)
+                    _tasks.push_back({ [](const void* fn, const size_t thread) { (*static_cast<const Work*>(fn))(thread); }, &work, t, &running });
+            }
+            _available.notify_all();
+            work(0);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _tasks.erase(std::remove_if(_tasks.begin(), _tasks.end(), [&](const _task& task) { return task.running == &running; }), _tasks.end());
+            _finished.wait(lock, [&] { return running == 0; });
+        }
+
+    private:
+        struct _task
+        {
+            void (*call)(const void* fn, size_t thread);
+            const void* fn;
+            size_t thread;
+            size_t* running; // the started tasks of the call which have not finished, under `_mutex`
+        };
+
+        void _work()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (true)
+            {
+                _available.wait(lock, [&] { return _stopping || !_tasks.empty(); });
+
+                if (_tasks.empty())
+                    return;
+                const _task task = _tasks.front();
+                _tasks.pop_front();
+                ++*task.running;
+
+                lock.unlock();
+                task.call(task.fn, task.thread);
+                lock.lock();
+
+                if (--*task.running == 0)
+                    _finished.notify_all();
+            }
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _available, _finished;
+        std::deque<_task> _tasks;
+        std::vector<std::thread> _threads;
+        bool _stopping = false;
+    };
+
+    inline _thread_pool& _pool()
+    {
+        static _thread_pool pool;
+        return pool;
+    }
+}
+
+/// @brief Runs a function over the index range [0, count) on several threads
+/// @details The range is split into chunks of `grain` indices which the threads claim in turn,
+///          so that uneven work balances out. `fn(first, last, thread)` is called once per chunk
+///          [first, last), with `thread` in [0, threads). The calling thread takes part as
+///          thread 0; the function returns when all chunks are done. The other threads come from
+///          a pool which is started on first use and reused by later calls.
+///
+///          Chunk `first / grain` always covers the same indices, so per-chunk results can be
+///          combined in a deterministic order.
+///
+/// @note `fn` must not throw
+/// @param threads The number of threads, 0 for `default_thread_count()`
+template<class Fn>
+inline void parallel_for(const size_t count, const size_t grain, const size_t threads, const Fn& fn)
+{
+    const size_t step = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + step - 1) / step;
+    const size_t workers = std::min(threads ? threads : default_thread_count(), chunks);
+
+    if (workers <= 1)
+    {
+        for (size_t first = 0; first < count; first += step)
+            fn(first, std::min(first + step, count), size_t(0));
+        return;
+    }
+
+    std::atomic<size_t> next = 0;
+    impl::_pool().run(workers - 1, [&](const size_t thread)
+    {
+        for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed); chunk < chunks; chunk = next.fetch_add(1, std::memory_order_relaxed))
+            fn(chunk * step, std::min((chunk + 1) * step, count), thread);
+    });
+}
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,286 @@
+#pragma once
+#include "parallel.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief The integration methods of `particle_system::step`
+enum class integrator
+{
+    /// @brief Symplectic Euler: `v += a * dt`, then `x += v * dt`
+    semi_implicit_euler,
+
+    /// @brief Velocity Verlet: `v_half = v + a(x, v) * dt / 2`, `x += v_half * dt`, then
+    ///        `v = v_half + a(x, v_half) * dt / 2`. Second order accurate when the acceleration depends
+    ///        on the position, at the cost of evaluating it twice
+    velocity_verlet,
+};
+
+/// @brief Particles stored as structure of arrays, advanced by a fused integration step
+/// @details Each component of the positions, velocities and forces is a contiguous array, e.g.
+///          `positions(1)[i]` is the y coordinate of particle `i`. A step reads the current positions
+///          and velocities and writes the next ones to a second set of arrays, which then become the
+///          current ones: stepping never allocates, and the state before the last step remains
+///          readable through `previous_positions` and `previous_velocities`.
+///
+///          The forces are inputs of the step, written by the caller beforehand; they are not
+///          double buffered
+/// @param Allocator Allocator for the arrays
+template<class Scalar, size_t Size, class Allocator = std::allocator<Scalar>>
+class particle_system
+{
+public:
+    using vector_t = vector<Scalar, Size>;
+
+    static_assert(std::is_floating_point_v<Scalar>, "Particles have to be of a floating point type");
+
+    /// @brief Creates particles at rest at the origin
+    explicit particle_system(const size_t count = 0, const Allocator& allocator = Allocator())
+        : _positions{ _buffer_t(allocator), _buffer_t(allocator) }, _velocities{ _buffer_t(allocator), _buffer_t(allocator) },
+          _forces(allocator)
+    {
+        resize(count);
+    }
+
+    /// @brief Changes the number of particles
+    /// @details New particles are at rest at the origin. The only operation which allocates
+    void resize(const size_t count)
+    {
+        for (_buffer_t* buffers : { _positions, _velocities })
+        {
+            for (size_t b = 0; b < 2; b++)
+                _resize(buffers[b], count);
+        }
+        _resize(_forces, count);
+        _count = count;
+    }
+
+    /// @brief Gets the number of particles
+    size_t size() const noexcept
+    {
+        return _count;
+    }
+
+    /// @brief Gets the array of a component of the positions
+    Scalar* positions(const size_t component) noexcept
+    {
+        return _component(_positions[_front], component);
+    }
+
+    /// @copydoc positions
+    const Scalar* positions(const size_t component) const noexcept
+    {
+        return _component(_positions[_front], component);
+    }
+
+    /// @brief Gets the array of a component of the velocities
+    Scalar* velocities(const size_t component) noexcept
+    {
+        return _component(_velocities[_front], component);
+    }
+
+    /// @copydoc velocities
+    const Scalar* velocities(const size_t component) const noexcept
+    {
+        return _component(_velocities[_front], component);
+    }
+
+    /// @brief Gets the array of a component of the forces
+    Scalar* forces(const size_t component) noexcept
+    {
+        return _component(_forces, component);
+    }
+
+    /// @copydoc forces
+    const Scalar* forces(const size_t component) const noexcept
+    {
+        return _component(_forces, component);
+    }
+
+    /// @brief Gets the array of a component of the positions before the last step
+    const Scalar* previous_positions(const size_t component) const noexcept
+    {
+        return _component(_positions[!_front], component);
+    }
+
+    /// @brief Gets the array of a component of the velocities before the last step
+    const Scalar* previous_velocities(const size_t component) const noexcept
+    {
+        return _component(_velocities[!_front], component);
+    }
+
+    /// @brief Gets the position of a particle
+    vector_t position(const size_t i) const noexcept
+    {
+        return _load(_positions[_front], i);
+    }
+
+    /// @brief Gets the velocity of a particle
+    vector_t velocity(const size_t i) const noexcept
+    {
+        return _load(_velocities[_front], i);
+    }
+
+    /// @brief Gets the force on a particle
+    vector_t force(const size_t i) const noexcept
+    {
+        return _load(_forces, i);
+    }
+
+    /// @brief Sets the position of a particle
+    void set_position(const size_t i, const vector_t& position) noexcept
+    {
+        _store(_positions[_front], i, position);
+    }
+
+    /// @brief Sets the velocity of a particle
+    void set_velocity(const size_t i, const vector_t& velocity) noexcept
+    {
+        _store(_velocities[_front], i, velocity);
+    }
+
+    /// @brief Sets the force on a particle
+    void set_force(const size_t i, const vector_t& force) noexcept
+    {
+        _store(_forces, i, force);
+    }
+
+    /// @brief Advances all particles by a time step
+    /// @details `acceleration(position, velocity, force)` is called for each particle with vectors of
+    ///          its state and returns its acceleration, e.g.
+    ///          `[&](const auto& x, const auto& v, const auto& f) -> float3d { return f * inverse_mass - v * drag + gravity; }`.
+    ///          The function is inlined into the loop over the particles, which the compiler can
+    ///          vectorize. The forces are held constant over the step
+    /// @param threads The number of threads, 0 for `default_thread_count()`
+    template<class Acceleration>
+    void step(const Scalar dt, const Acceleration& acceleration, const integrator method = integrator::semi_implicit_euler, const size_t threads = 1)
+    {
+        static_assert(std::is_same_v<std::invoke_result_t<const Acceleration&, const vector_t&, const vector_t&, const vector_t&>, vector_t>,
+                      "The acceleration has to be returned as a vector value; an expression would refer to temporaries of the function");
+
+        if (method == integrator::semi_implicit_euler)
+            _step<integrator::semi_implicit_euler>(dt, acceleration, threads);
+        else
+            _step<integrator::velocity_verlet>(dt, acceleration, threads);
+        _front = !_front;
+    }
+
+private:
+    using _buffer_t = std::vector<Scalar, Allocator>;
+
+    // the number of particles claimed at once by a thread
+    static constexpr size_t _grain = 4096;
+
+    // the number of particles computed on the stack before being written out
+    static constexpr size_t _block = 256;
+
+    void _resize(_buffer_t& buffer, const size_t count) const
+    {
+        // components are laid out one after another, so each keeps its values when resizing
+        _buffer_t resized(Size * count, Scalar(0), buffer.get_allocator());
+
+        for (size_t c = 0; c < Size; c++)
+            std::copy_n(buffer.begin() + c * _count, std::min(count, _count), resized.begin() + c * count);
+        buffer.swap(resized);
+    }
+
+    Scalar* _component(_buffer_t& buffer, const size_t component) const noexcept
+    {
+        return buffer.data() + component * _count;
+    }
+
+    const Scalar* _component(const _buffer_t& buffer, const size_t component) const noexcept
+    {
+        return buffer.data() + component * _count;
+    }
+
+    vector_t _load(const _buffer_t& buffer, const size_t i) const noexcept
+    {
+        vector_t out;
+
+        for (size_t c = 0; c < Size; c++)
+            out[c] = buffer[c * _count + i];
+        return out;
+    }
+
+    void _store(_buffer_t& buffer, const size_t i, const vector_t& value) noexcept
+    {
+        for (size_t c = 0; c < Size; c++)
+            buffer[c * _count + i] = value[c];
+    }
+
+    // reads the current state and writes the next to the back buffers, a block of particles at a time.
+    // The block is computed into arrays on the stack, which the compiler knows do not alias the
+    // buffers, and then copied: with stores to the buffers in the same loop, it gives up
+    // vectorizing over the run-time checks of every pair of arrays
+    template<integrator Method, class Acceleration>
+    void _step(const Scalar dt, const Acceleration& acceleration, const size_t threads)
+    {
+        parallel_for(_count, _grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            // component c of particle i is at [c * count + i]
+            const Scalar* const x = _positions[_front].data();
+            const Scalar* const v = _velocities[_front].data();
+            const Scalar* const f = _forces.data();
+            const size_t count = _count;
+
+            Scalar next_x[Size][_block], next_v[Size][_block];
+
+            for (size_t block = first; block < last; block += _block)
+            {
+                const size_t width = std::min(_block, last - block);
+
+                for (size_t j = 0; j < width; j++)
+                {
+                    const size_t i = block + j;
+                    vector_t position, velocity, force;
+
+                    for (size_t c = 0; c < Size; c++)
+                    {
+                        position[c] = x[c * count + i];
+                        velocity[c] = v[c * count + i];
+                        force[c] = f[c * count + i];
+                    }
+
+                    vector_t next_position, next_velocity;
+
+                    if constexpr(Method == integrator::semi_implicit_euler)
+                    {
+                        next_velocity = velocity + acceleration(std::as_const(position), std::as_const(velocity), std::as_const(force)) * dt;
+                        next_position = position + next_velocity * dt;
+                    }
+                    else
+                    {
+                        const vector_t half = velocity + acceleration(std::as_const(position), std::as_const(velocity), std::as_const(force)) * (dt / 2);
+
+                        next_position = position + half * dt;
+                        next_velocity = half + acceleration(std::as_const(next_position), half, std::as_const(force)) * (dt / 2);
+                    }
+
+                    for (size_t c = 0; c < Size; c++)
+                    {
+                        next_x[c][j] = next_position[c];
+                        next_v[c][j] = next_velocity[c];
+                    }
+                }
+                for (size_t c = 0; c < Size; c++)
+                {
+                    std::copy_n(next_x[c], width, _positions[!_front].begin() + c * count + block);
+                    std::copy_n(next_v[c], width, _velocities[!_front].begin() + c * count + block);
+                }
+            }
+        });
+    }
+
+    _buffer_t _positions[2];
+    _buffer_t _velocities[2];
+    _buffer_t _forces;
+    size_t _count = 0;
+    bool _front = 0;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,404 @@
+#pragma once
+#include "parallel.h"
+#include <charconv>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief The encodings of vectors read and written by `pipeline`
+enum class stream_format
+{
+    /// @brief The components of each vector as raw scalars in native byte order, without separators
+    binary,
+
+    /// @brief Numbers separated by whitespace, commas or parentheses, taken `Size` at a time; e.g. one
+    ///        vector per line, or the output of `to_string`. Written as one vector per line with the
+    ///        components separated by spaces, in the shortest form which reads back exactly
+    text,
+};
+
+/// @brief How a `pipeline` run ended
+enum class pipeline_status
+{
+    ok,
+
+    /// @brief The input could not be opened or read
+    read_error,
+
+    /// @brief The input held something other than a number, or ended within a vector
+    parse_error,
+
+    /// @brief The output could not be opened or written
+    write_error,
+};
+
+/// @brief The outcome of a `pipeline` run
+struct pipeline_result
+{
+    pipeline_status status = pipeline_status::ok;
+
+    /// @brief The number of vectors written, all of which were complete when the run failed
+    size_t count = 0;
+};
+
+namespace impl
+{
+    // a blocking queue of chunk indices. Closing it wakes and fails all pops, which is how the
+    // threads of a pipeline are stopped when one of them fails
+    class _chunk_queue
+    {
+    public:
+        void push(const size_t chunk)
+        {
+            {
+                const std::lock_guard<std::mutex> lock(_mutex);
+                _chunks.push(chunk);
+            }
+            _ready.notify_one();
+        }
+
+        bool pop(size_t& chunk)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _ready.wait(lock, [&] { return _closed || !_chunks.empty(); });
+
+            if (_closed)
+                return false;
+            chunk = _chunks.front();
+            _chunks.pop();
+            return true;
+        }
+
+        void close()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+            }
+            _ready.notify_all();
+        }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _ready;
+        std::queue<size_t> _chunks;
+        bool _closed = false;
+    };
+}
+
+/// @brief Streams vectors from an input through a chain of transforms to an output, in constant memory
+/// @details The input is read in chunks of `chunk_size` vectors, which pass through three threads:
+///          one reads and parses, one (the caller, with helpers if requested) applies the stages,
+///          and one formats and writes. The chunks are recycled from a fixed pool of `chunk_count`,
+///          so that reading, computing and writing overlap while memory stays at
+///          `chunk_count * chunk_size` vectors plus two text buffers, whatever the size of the input.
+///
+///          The stages are applied to blocks of vectors small enough to stay in the cache, every
+///          stage to a block before moving to the next block, so a chain costs one pass over memory
+///          rather than one per stage.
+///
+///          Text is parsed with `std::from_chars` and formatted with `std::to_chars`, without locales
+///          or per-number stream operations
+template<class Scalar, size_t Size>
+class pipeline
+{
+public:
+    using vector_t = vector<Scalar, Size>;
+
+    static_assert(sizeof(vector_t) == Size * sizeof(Scalar), "Vectors have to be packed to be read and written as binary");
+
+    /// @brief The number of chunks in flight
+    static constexpr size_t chunk_count = 4;
+
+    /// @param chunk_size The number of vectors read at once
+    /// @param threads The number of threads applying the stages, 0 for `default_thread_count()`.
+    ///                The reading and writing threads come on top
+    explicit pipeline(const size_t chunk_size = 65536, const size_t threads = 1)
+        : _chunk_size(std::max<size_t>(chunk_size, 1)), _threads(threads)
+    {}
+
+    /// @brief Appends a stage, `fn(vector)` returning the transformed vector
+    /// @details E.g. `then([&](const float3d& v) -> float3d { return rotation * v + offset; })`.
+    ///          Stages may be called from several threads at once, each on different vectors
+    template<class Fn>
+    pipeline& then(Fn fn)
+    {
+        static_assert(std::is_same_v<std::invoke_result_t<const Fn&, const vector_t&>, vector_t>,
+                      "Stages have to return a vector value; an expression would refer to temporaries of the stage");
+
+        _stages.emplace_back([fn = std::move(fn)](vector_t* data, const size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                const vector_t result = fn(std::as_const(data[i]));
+                data[i] = result;
+            }
+        });
+        return *this;
+    }
+
+    /// @brief Reads all vectors of a stream, transforms them and writes them to another
+    /// @details Stops at the first error; the vectors of the chunks written before it are in the
+    ///          output. The output is flushed
+    pipeline_result run(std::istream& in, const stream_format in_format, std::ostream& out, const stream_format out_format) const
+    {
+        return _run(*this, in, in_format, out, out_format).run();
+    }
+
+    /// @brief Reads all vectors of a file, transforms them and writes them to another
+    /// @details The files are opened in binary mode whatever the format, so text is read and
+    ///          written with `\n` line endings
+    pipeline_result run(const std::string& input, const stream_format in_format, const std::string& output, const stream_format out_format) const
+    {
+        std::ifstream in(input, std::ios::binary);
+
+        if (!in)
+            return { pipeline_status::read_error, 0 };
+
+        std::ofstream out(output, std::ios::binary | std::ios::trunc);
+
+        if (!out)
+            return { pipeline_status::write_error, 0 };
+        return run(in, in_format, out, out_format);
+    }
+
+private:
+    using _stage_t = std::function<void(vector_t*, size_t)>;
+
+    // the number of vectors passed through all stages at a time
+    static constexpr size_t _block = 1024;
+
+    // the size of the buffers of text read and written at a time
+    static constexpr size_t _text_buffer = size_t(1) << 16;
+
+    // more than the characters of the shortest exact form of any scalar
+    static constexpr size_t _max_chars = 64;
+
+    // the index pushed after the last chunk
+    static constexpr size_t _end = SIZE_MAX;
+
+    static constexpr bool _is_separator(const char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',' || c == '(' || c == ')';
+    }
+
+    // the state of one run: chunks go from `free` to the reader, then through `read` to the stages,
+    // through `computed` to the writer, and back to `free`
+    struct _run
+    {
+        _run(const pipeline& self, std::istream& in, const stream_format in_format, std::ostream& out, const stream_format out_format)
+            : self(self), in(in), in_format(in_format), out(out), out_format(out_format)
+        {}
+
+        const pipeline& self;
+        std::istream& in;
+        stream_format in_format;
+        std::ostream& out;
+        stream_format out_format;
+
+        std::vector<vector_t> data[chunk_count];
+        size_t counts[chunk_count] = {};
+        impl::_chunk_queue free, read, computed;
+
+        std::mutex mutex;
+        pipeline_status status = pipeline_status::ok;
+        size_t written = 0;
+
+        pipeline_result run()
+        {
+            for (size_t c = 0; c < chunk_count; c++)
+            {
+                data[c].resize(self._chunk_size);
+                free.push(c);
+            }
+
+            std::thread reader([&] { in_format == stream_format::binary ? read_binary() : read_text(); });
+            std::thread writer([&] { write(); });
+            size_t chunk;
+
+            while (read.pop(chunk))
+            {
+                if (chunk != _end)
+                {
+                    parallel_for(counts[chunk], _block, self._threads, [&](const size_t first, const size_t last, size_t)
+                    {
+                        for (const _stage_t& stage : self._stages)
+                            stage(data[chunk].data() + first, last - first);
+                    });
+                }
+                computed.push(chunk);
+
+                if (chunk == _end)
+                    break;
+            }
+            reader.join();
+            writer.join();
+            return { status, written };
+        }
+
+        // records the first error and stops all threads
+        void fail(const pipeline_status error)
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+
+                if (status == pipeline_status::ok)
+                    status = error;
+            }
+            free.close();
+            read.close();
+            computed.close();
+        }
+
+        void read_binary()
+        {
+            size_t chunk;
+
+            while (free.pop(chunk))
+            {
+                in.read(reinterpret_cast<char*>(data[chunk].data()), std::streamsize(self._chunk_size * sizeof(vector_t)));
+
+                const size_t bytes = size_t(in.gcount());
+                counts[chunk] = bytes / sizeof(vector_t);
+
+                if (in.bad())
+                    return fail(pipeline_status::read_error);
+                if (bytes % sizeof(vector_t) != 0)
+                    return fail(pipeline_status::parse_error);
+                if (counts[chunk] != 0)
+                    read.push(chunk);
+                if (in.eof())
+                    return read.push(_end);
+            }
+        }
+
+        void read_text()
+        {
+            std::vector<char> buffer(_text_buffer);
+            size_t begin = 0, end = 0, chunk = 0, component = 0;
+            bool eof = false;
+
+            if (!free.pop(chunk))
+                return;
+            counts[chunk] = 0;
+
+            while (true)
+            {
+                // the next number, refilling the buffer when it is cut off at its end
+                while (begin < end && _is_separator(buffer[begin]))
+                    begin++;
+
+                size_t token = begin;
+
+                while (token < end && !_is_separator(buffer[token]))
+                    token++;
+
+                if (token == end && !eof)
+                {
+                    if (begin == 0 && end == buffer.size())
+                        return fail(pipeline_status::parse_error);
+
+                    std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+                    end -= begin;
+                    begin = 0;
+                    in.read(buffer.data() + end, std::streamsize(buffer.size() - end));
+                    end += size_t(in.gcount());
+                    eof = in.eof();
+
+                    if (in.bad())
+                        return fail(pipeline_status::read_error);
+                    continue;
+                }
+                if (begin == end)
+                    break;
+
+                Scalar& value = data[chunk][counts[chunk]][component];
+                const auto [last, error] = std::from_chars(buffer.data() + begin, buffer.data() + token, value);
+
+                if (error != std::errc() || last != buffer.data() + token)
+                    return fail(pipeline_status::parse_error);
+                begin = token;
+
+                if (++component < Size)
+                    continue;
+                component = 0;
+
+                if (++counts[chunk] == self._chunk_size)
+                {
+                    read.push(chunk);
+
+                    if (!free.pop(chunk))
+                        return;
+                    counts[chunk] = 0;
+                }
+            }
+            if (component != 0)
+                return fail(pipeline_status::parse_error);
+            if (counts[chunk] != 0)
+                read.push(chunk);
+            read.push(_end);
+        }
+
+        void write()
+        {
+            std::vector<char> buffer(out_format == stream_format::text ? _text_buffer : 0);
+            size_t chunk;
+
+            while (computed.pop(chunk))
+            {
+                if (chunk == _end)
+                {
+                    if (!out.flush())
+                        fail(pipeline_status::write_error);
+                    return;
+                }
+
+                const vector_t* vectors = data[chunk].data();
+
+                if (out_format == stream_format::binary)
+                    out.write(reinterpret_cast<const char*>(vectors), std::streamsize(counts[chunk] * sizeof(vector_t)));
+                else
+                {
+                    char* const first = buffer.data();
+                    char* const last = first + buffer.size() - Size * _max_chars;
+                    char* cursor = first;
+
+                    for (size_t i = 0; i < counts[chunk]; i++)
+                    {
+                        for (size_t c = 0; c < Size; c++)
+                        {
+                            cursor = std::to_chars(cursor, cursor + _max_chars - 1, vectors[i][c]).ptr;
+                            *cursor++ = c + 1 < Size ? ' ' : '\n';
+                        }
+                        if (cursor > last || i + 1 == counts[chunk])
+                        {
+                            out.write(first, cursor - first);
+                            cursor = first;
+                        }
+                    }
+                }
+                if (!out)
+                    return fail(pipeline_status::write_error);
+
+                written += counts[chunk];
+                free.push(chunk);
+            }
+        }
+    };
+
+    size_t _chunk_size;
+    size_t _threads;
+    std::vector<_stage_t> _stages;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,381 @@
+#pragma once
+#include "dandy.h"
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief The xoshiro256++ pseudo-random number generator
+/// @details A small and fast generator with a period of 2^256 - 1, passing all common statistical
+///          tests. Satisfies `UniformRandomBitGenerator`, so it can be used with the standard
+///          distributions as well.
+///
+///          Generators constructed with the same seed and different streams produce sequences
+///          which are 2^192 draws apart and do not overlap in practice, e.g. one stream per
+///          thread gives reproducible results regardless of the scheduling of the threads
+class xoshiro256
+{
+public:
+    using result_type = uint64_t;
+
+    /// @param seed Any value; expanded to the full state with SplitMix64
+    /// @param stream The index of the stream, for independent sequences from the same seed
+    constexpr explicit xoshiro256(const uint64_t seed = 0, const uint64_t stream = 0) noexcept
+    {
+        uint64_t x = seed;
+
+        for (uint64_t& s : _s)
+            s = _splitmix64(x);
+        for (uint64_t i = 0; i < stream; i++)
+            long_jump();
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return UINT64_MAX;
+    }
+
+    /// @brief Draws the next 64 random bits
+    constexpr result_type operator()() noexcept
+    {
+        const uint64_t out = _rotl(_s[0] + _s[3], 23) + _s[0];
+        const uint64_t t = _s[1] << 17;
+
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = _rotl(_s[3], 45);
+        return out;
+    }
+
+    /// @brief Advances the generator by 2^128 draws
+    constexpr void jump() noexcept
+    {
+        constexpr uint64_t polynomial[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+        _jump(polynomial);
+    }
+
+    /// @brief Advances the generator by 2^192 draws
+    constexpr void long_jump() noexcept
+    {
+        constexpr uint64_t polynomial[] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+        _jump(polynomial);
+    }
+
+    /// @brief Gets the 256 bits of state
+    constexpr const uint64_t* state() const noexcept
+    {
+        return _s;
+    }
+private:
+    static constexpr uint64_t _rotl(const uint64_t x, const int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static constexpr uint64_t _splitmix64(uint64_t& x) noexcept
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    constexpr void _jump(const uint64_t (&polynomial)[4]) noexcept
+    {
+        uint64_t s[4] = {};
+
+        for (const uint64_t word : polynomial)
+        {
+            for (int bit = 0; bit < 64; bit++)
+            {
+                if (word & (uint64_t(1) << bit))
+                {
+                    for (size_t i = 0; i < 4; i++)
+                        s[i] ^= _s[i];
+                }
+                (*this)();
+            }
+        }
+        for (size_t i = 0; i < 4; i++)
+            _s[i] = s[i];
+    }
+
+    uint64_t _s[4] = {};
+};
+
+/// @brief Several xoshiro256++ generators advanced in lockstep, for generating in bulk
+/// @details The states of the lanes are laid out so that the update of all lanes compiles to
+///          vector instructions. Lane `i` is the stream's generator advanced by `i` jumps of
+///          2^128 draws, and draws are returned from the lanes in turn. Prefer `generate` over
+///          single draws where many numbers are needed at once
+/// @param Lanes The number of generators; a multiple of the SIMD width in 64-bit elements
+template<size_t Lanes = 8>
+class xoshiro256x
+{
+    static_assert(Lanes > 0, "At least one lane is required");
+public:
+    using result_type = uint64_t;
+
+    /// @param seed Any value; expanded to the full state with SplitMix64
+    /// @param stream The index of the stream, see `xoshiro256`
+    explicit xoshiro256x(const uint64_t seed = 0, const uint64_t stream = 0) noexcept
+    {
+        xoshiro256 lane(seed, stream);
+
+        for (size_t i = 0; i < Lanes; i++)
+        {
+            for (size_t j = 0; j < 4; j++)
+                _s[j][i] = lane.state()[j];
+            lane.jump();
+        }
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return UINT64_MAX;
+    }
+
+    /// @brief Draws the next 64 random bits
+    result_type operator()() noexcept
+    {
+        if (_next == Lanes)
+        {
+            _step(_buffer);
+            _next = 0;
+        }
+        return _buffer[_next++];
+    }
+
+    /// @brief Draws `count` times 64 random bits
+    /// @details Produces the same numbers as calling the generator `count` times
+    void generate(uint64_t* out, size_t count) noexcept
+    {
+        for (; count && _next < Lanes; count--)
+            *out++ = _buffer[_next++];
+
+        for (; count >= Lanes; count -= Lanes, out += Lanes)
+            _step(out);
+
+        for (; count; count--)
+            *out++ = (*this)();
+    }
+private:
+    static constexpr uint64_t _rotl(const uint64_t x, const int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    void _step(uint64_t* const out) noexcept
+    {
+        uint64_t result[Lanes]; // written to `out` afterwards, which might otherwise alias the state
+
+        for (size_t i = 0; i < Lanes; i++)
+        {
+            const uint64_t t = _s[1][i] << 17;
+
+            result[i] = _rotl(_s[0][i] + _s[3][i], 23) + _s[0][i];
+            _s[2][i] ^= _s[0][i];
+            _s[3][i] ^= _s[1][i];
+            _s[1][i] ^= _s[2][i];
+            _s[0][i] ^= _s[3][i];
+            _s[2][i] ^= t;
+            _s[3][i] = _rotl(_s[3][i], 45);
+        }
+        std::copy(result, result + Lanes, out);
+    }
+
+    alignas(64) uint64_t _s[4][Lanes];
+    uint64_t _buffer[Lanes] = {};
+    size_t _next = Lanes;
+};
+
+namespace impl
+{
+    /// @brief The number of random numbers drawn at once by the distributions
+    inline constexpr size_t _random_block = 256;
+
+    template<class Generator, class = void>
+    inline constexpr bool _has_generate_v = false;
+
+    template<class Generator>
+    inline constexpr bool _has_generate_v<Generator, std::void_t<decltype(std::declval<Generator&>().generate(std::declval<uint64_t*>(), size_t()))>> = true;
+
+    template<class Generator>
+    inline void _generate(Generator& generator, uint64_t* const out, const size_t count)
+    {
+        static_assert(Generator::min() == 0 && Generator::max() == UINT64_MAX, "The generator has to produce 64 random bits per draw");
+
+        if constexpr(_has_generate_v<Generator>)
+            generator.generate(out, count);
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+                out[i] = generator();
+        }
+    }
+
+    /// @brief Converts random bits to a uniformly distributed scalar in [0, 1)
+    template<class Scalar>
+    constexpr Scalar _unit(const uint64_t bits) noexcept
+    {
+        if constexpr(std::is_same_v<Scalar, float>)
+            return static_cast<float>(bits >> 40) * 0x1.0p-24f;
+        else
+            return static_cast<Scalar>(static_cast<double>(bits >> 11) * 0x1.0p-53);
+    }
+}
+
+/// @brief Fills an array with vectors uniformly distributed in the box [lo, hi)
+/// @details The upper bound may be reached due to rounding
+template<class Scalar, size_t Size, class Generator>
+inline void random_in_box(Generator& generator, vector<Scalar, Size>* out, const size_t count,
+                          const vector<Scalar, Size>& lo = vector<Scalar, Size>::zero,
+                          const vector<Scalar, Size>& hi = vector<Scalar, Size>::identity)
+{
+    static_assert(std::is_floating_point_v<Scalar>, "Random vectors have to be of a floating point type");
+    constexpr size_t block = std::max<size_t>(impl::_random_block / Size, 1);
+
+    const vector<Scalar, Size> extent = hi - lo;
+    uint64_t bits[block * Size];
+
+    for (size_t first = 0; first < count; first += block)
+    {
+        const size_t n = std::min(block, count - first);
+        impl::_generate(generator, bits, n * Size);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < Size; j++)
+                out[first + i][j] = lo[j] + extent[j] * impl::_unit<Scalar>(bits[i * Size + j]);
+        }
+    }
+}
+
+/// @brief Fills an array with vectors uniformly distributed in the unit ball
+/// @details Samples the enclosing cube and rejects samples outside of the ball, which gets
+///          inefficient for vectors larger than 4 components
+template<class Scalar, size_t Size, class Generator>
+inline void random_in_ball(Generator& generator, vector<Scalar, Size>* out, const size_t count)
+{
+    static_assert(std::is_floating_point_v<Scalar>, "Random vectors have to be of a floating point type");
+    constexpr size_t block = std::max<size_t>(impl::_random_block / Size, 1);
+
+    uint64_t bits[block * Size];
+    size_t filled = 0;
+
+    while (filled < count)
+    {
+        const size_t n = std::min(block, count - filled);
+        impl::_generate(generator, bits, n * Size);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            vector<Scalar, Size> v;
+
+            for (size_t j = 0; j < Size; j++)
+                v[j] = Scalar(2) * impl::_unit<Scalar>(bits[i * Size + j]) - Scalar(1);
+            if (v.length2() <= Scalar(1))
+                out[filled++] = v;
+        }
+    }
+}
+
+/// @brief Fills an array with vectors normally distributed around a mean
+/// @details Box-Muller transform; every component is independently distributed
+/// @param stddev The standard deviation of each component
+template<class Scalar, size_t Size, class Generator>
+inline void random_gaussian(Generator& generator, vector<Scalar, Size>* out, const size_t count,
+                            const vector<Scalar, Size>& mean = vector<Scalar, Size>::zero, const Scalar stddev = 1)
+{
+    static_assert(std::is_floating_point_v<Scalar>, "Random vectors have to be of a floating point type");
+    constexpr size_t block = impl::_random_block;
+    constexpr Scalar two_pi = Scalar(6.28318530717958647692);
+
+    const size_t total = count * Size;
+    uint64_t bits[block];
+    Scalar values[block];
+
+    for (size_t first = 0; first < total; first += block)
+    {
+        const size_t n = std::min(block, total - first + (total - first) % 2);
+        impl::_generate(generator, bits, n);
+
+        for (size_t i = 0; i < n; i += 2)
+        {
+            const Scalar r = math::sqrt(Scalar(-2) * std::log(Scalar(1) - impl::_unit<Scalar>(bits[i])));
+            Scalar s = 0, c = 0;
+
+            math::sincos(two_pi * impl::_unit<Scalar>(bits[i + 1]), s, c);
+            values[i] = r * c;
+            values[i + 1] = r * s;
+        }
+        for (size_t i = 0; i < n && first + i < total; i++)
+        {
+            const size_t k = first + i;
+            out[k / Size][k % Size] = mean[k % Size] + stddev * values[i];
+        }
+    }
+}
+
+/// @brief Fills an array with vectors uniformly distributed on the unit sphere
+/// @details 2D and 3D vectors are sampled through their angles, larger vectors by normalizing
+///          normally distributed vectors
+template<class Scalar, size_t Size, class Generator>
+inline void random_on_sphere(Generator& generator, vector<Scalar, Size>* out, const size_t count)
+{
+    static_assert(std::is_floating_point_v<Scalar>, "Random vectors have to be of a floating point type");
+    constexpr Scalar two_pi = Scalar(6.28318530717958647692);
+
+    if constexpr(Size == 2 || Size == 3)
+    {
+        // one word for the angle, and one for the height of 3D vectors
+        constexpr size_t words = Size == 2 ? 1 : 2;
+        constexpr size_t block = impl::_random_block / words;
+        uint64_t bits[block * words];
+
+        for (size_t first = 0; first < count; first += block)
+        {
+            const size_t n = std::min(block, count - first);
+            impl::_generate(generator, bits, n * words);
+
+            for (size_t i = 0; i < n; i++)
+            {
+                Scalar s = 0, c = 0;
+                math::sincos(two_pi * impl::_unit<Scalar>(bits[words * i]), s, c);
+
+                if constexpr(Size == 2)
+                    out[first + i] = { c, s };
+                else
+                {
+                    // the height is uniformly distributed on a sphere (Archimedes)
+                    const Scalar z = Scalar(1) - Scalar(2) * impl::_unit<Scalar>(bits[words * i + 1]);
+                    const Scalar r = math::sqrt(std::max(Scalar(1) - z * z, Scalar(0)));
+
+                    out[first + i] = { r * c, r * s, z };
+                }
+            }
+        }
+    }
+    else
+    {
+        random_gaussian(generator, out, count);
+
+        for (size_t i = 0; i < count; i++)
+            out[i] = out[i] * (Scalar(1) / math::sqrt(out[i].length2()));
+    }
+}
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,158 @@
+#pragma once
+#include "dandy.h"
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief A packet of rays traced together, stored as structure of arrays
+/// @details Component `c` of the origin of ray `i` is `origin[c][i]`. The packet kernels below
+///          loop over the lanes without branching, so that they compile to vector instructions
+///          processing several rays at once
+/// @param Scalar The floating point type of the rays
+/// @param Lanes The number of rays; a power of two up to 32, e.g. the SIMD width
+template<class Scalar, size_t Lanes>
+struct ray_packet
+{
+    static_assert(std::is_floating_point_v<Scalar>, "Rays have to be of a floating point type");
+    static_assert(Lanes > 0 && Lanes <= 32 && (Lanes & (Lanes - 1)) == 0, "The number of lanes has to be a power of two up to 32");
+
+    /// @brief The number of rays in the packet
+    static constexpr size_t lanes = Lanes;
+
+    /// @brief Default constructs the packet
+    /// @details The rays are left uninitialized
+    ray_packet() = default;
+
+    /// @brief Loads `Lanes` rays from arrays of origins and directions
+    ray_packet(const vector<Scalar, 3>* origins, const vector<Scalar, 3>* directions) noexcept
+    {
+        for (size_t i = 0; i < Lanes; i++)
+            set(i, origins[i], directions[i]);
+    }
+
+    /// @brief Sets the ray of a lane
+    /// @details The direction does not need to be normalized; distances are measured in
+    ///          multiples of its length
+    void set(const size_t lane, const vector<Scalar, 3>& origin, const vector<Scalar, 3>& direction) noexcept
+    {
+        for (size_t c = 0; c < 3; c++)
+        {
+            this->origin[c][lane] = origin[c];
+            this->direction[c][lane] = direction[c];
+            inverse_direction[c][lane] = Scalar(1) / direction[c];
+        }
+    }
+
+    alignas(Lanes * sizeof(Scalar)) Scalar origin[3][Lanes];
+    alignas(Lanes * sizeof(Scalar)) Scalar direction[3][Lanes];
+
+    /// @brief The reciprocal of each direction component, used by the box test
+    alignas(Lanes * sizeof(Scalar)) Scalar inverse_direction[3][Lanes];
+};
+
+/// @brief The closest hits found so far for a packet of rays
+/// @details Updated by `intersect_triangle`, which only accepts hits closer than `t`
+template<class Scalar, size_t Lanes>
+struct packet_hit
+{
+    /// @param t_max The distance beyond which hits are ignored
+    explicit packet_hit(const Scalar t_max = std::numeric_limits<Scalar>::infinity()) noexcept
+    {
+        for (size_t i = 0; i < Lanes; i++)
+        {
+            t[i] = t_max;
+            u[i] = v[i] = 0;
+        }
+    }
+
+    /// @brief The distance to the closest hit, in multiples of the ray direction
+    alignas(Lanes * sizeof(Scalar)) Scalar t[Lanes];
+
+    /// @brief The barycentric coordinates of the closest hit: the hit point is
+    ///        `(1 - u - v) * v0 + u * v1 + v * v2`
+    alignas(Lanes * sizeof(Scalar)) Scalar u[Lanes];
+    alignas(Lanes * sizeof(Scalar)) Scalar v[Lanes];
+};
+
+namespace impl
+{
+    template<size_t Lanes>
+    inline uint32_t _to_mask(const bool (&hits)[Lanes]) noexcept
+    {
+        uint32_t out = 0;
+
+        for (size_t i = 0; i < Lanes; i++)
+            out |= uint32_t(hits[i]) << i;
+        return out;
+    }
+}
+
+/// @brief Intersects a packet of rays with a triangle (Möller-Trumbore)
+/// @details Hits in front of the origin and closer than the packet's current hits replace them.
+///          Triangles are hit from both sides; rays parallel to the triangle never hit
+/// @return The mask of the lanes whose closest hit was replaced, bit `i` for lane `i`
+template<class Scalar, size_t Lanes>
+inline uint32_t intersect_triangle(const ray_packet<Scalar, Lanes>& rays, const vector<Scalar, 3>& v0, const vector<Scalar, 3>& v1,
+                                   const vector<Scalar, 3>& v2, packet_hit<Scalar, Lanes>& hit) noexcept
+{
+    const vector<Scalar, 3> e1 = v1 - v0;
+    const vector<Scalar, 3> e2 = v2 - v0;
+    bool hits[Lanes];
+
+    for (size_t i = 0; i < Lanes; i++)
+    {
+        const Scalar dx = rays.direction[0][i], dy = rays.direction[1][i], dz = rays.direction[2][i];
+        const Scalar sx = rays.origin[0][i] - v0[0], sy = rays.origin[1][i] - v0[1], sz = rays.origin[2][i] - v0[2];
+
+        // p = d x e2, q = s x e1
+        const Scalar px = dy * e2[2] - dz * e2[1], py = dz * e2[0] - dx * e2[2], pz = dx * e2[1] - dy * e2[0];
+        const Scalar qx = sy * e1[2] - sz * e1[1], qy = sz * e1[0] - sx * e1[2], qz = sx * e1[1] - sy * e1[0];
+
+        const Scalar det = e1[0] * px + e1[1] * py + e1[2] * pz;
+        const Scalar inverse = Scalar(1) / det;
+        const Scalar u = (sx * px + sy * py + sz * pz) * inverse;
+        const Scalar v = (dx * qx + dy * qy + dz * qz) * inverse;
+        const Scalar t = (e2[0] * qx + e2[1] * qy + e2[2] * qz) * inverse;
+
+        // a zero determinant makes all of them infinite or NaN, failing the comparisons. The
+        // conditions are combined with `&` rather than `&&` to keep the loop free of branches
+        hits[i] = (det != Scalar(0)) & (u >= Scalar(0)) & (v >= Scalar(0)) & (u + v <= Scalar(1)) & (t > Scalar(0)) & (t < hit.t[i]);
+        hit.t[i] = hits[i] ? t : hit.t[i];
+        hit.u[i] = hits[i] ? u : hit.u[i];
+        hit.v[i] = hits[i] ? v : hit.v[i];
+    }
+    return impl::_to_mask(hits);
+}
+
+/// @brief Intersects a packet of rays with an axis-aligned box (slab test)
+/// @details Rays starting inside the box hit it at distance 0
+/// @param t_max The distance beyond which each ray ignores the box, e.g. `packet_hit::t`
+/// @param t_near Receives the distance at which each ray enters the box, valid for the hit lanes
+/// @return The mask of the lanes hitting the box before `t_max`, bit `i` for lane `i`
+template<class Scalar, size_t Lanes>
+inline uint32_t intersect_box(const ray_packet<Scalar, Lanes>& rays, const vector<Scalar, 3>& lo, const vector<Scalar, 3>& hi,
+                              const Scalar (&t_max)[Lanes], Scalar (&t_near)[Lanes]) noexcept
+{
+    bool hits[Lanes];
+
+    for (size_t i = 0; i < Lanes; i++)
+    {
+        Scalar near = 0;
+        Scalar far = t_max[i];
+
+        for (size_t c = 0; c < 3; c++)
+        {
+            const Scalar t1 = (lo[c] - rays.origin[c][i]) * rays.inverse_direction[c][i];
+            const Scalar t2 = (hi[c] - rays.origin[c][i]) * rays.inverse_direction[c][i];
+
+            near = std::max(near, std::min(t1, t2));
+            far = std::min(far, std::max(t1, t2));
+        }
+        hits[i] = near <= far;
+        t_near[i] = near;
+    }
+    return impl::_to_mask(hits);
+}
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,343 @@
+#pragma once
+#include "parallel.h"
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+/// @brief How `compressed_trajectory` predicts each value from the previous ones
+enum class trajectory_predictor
+{
+    /// @brief The previous value: small residuals for slowly changing values
+    delta,
+
+    /// @brief Extrapolation of the two previous values: small residuals for values changing at a
+    ///        slowly changing rate, e.g. positions under smooth motion
+    linear,
+};
+
+/// @brief A time series of vectors stored compressed in blocks
+/// @details The vectors are grouped in blocks of `block_size`. Each component is mapped to an integer:
+///          rounded to a multiple of a quantum, or its bit pattern when there is none. Within a block
+///          a component is stored as its first value and difference, followed by the residuals of
+///          the predictor: zigzag encoded so that small negative residuals are small numbers, and bit
+///          packed at the width of the largest residual of the block.
+///
+///          Blocks are decoded independently of each other, so that a range is decoded by its blocks
+///          alone and a whole series by several threads. Decoding runs in passes over a block which
+///          the compiler vectorizes: unpacking, zigzag decoding, the prefix sums undoing the predictor
+///          and the conversion back to scalars.
+///
+///          The last, incomplete block is stored uncompressed until it fills up
+/// @param Allocator Allocator for the internal arrays, rebound to the element types
+template<class Scalar, size_t Size, class Allocator = std::allocator<Scalar>>
+class compressed_trajectory
+{
+public:
+    using vector_t = vector<Scalar, Size>;
+
+    static_assert(std::is_arithmetic_v<Scalar> && sizeof(Scalar) <= 8, "Trajectories have to be of an arithmetic type of up to 64 bits");
+
+    /// @brief The number of vectors per block
+    static constexpr size_t block_size = 256;
+
+    /// @param quantum For floating point types, the step to which components are rounded, so that
+    ///                decoded values are within `quantum / 2` of the original ones; 0 to store them
+    ///                exactly. Components must be less than `quantum * 2^62` in magnitude. Ignored for
+    ///                integral types, which are always stored exactly
+    explicit compressed_trajectory(const Scalar quantum = 0, const trajectory_predictor predictor = trajectory_predictor::linear,
+                                   const Allocator& allocator = Allocator())
+        : _quantum(std::is_floating_point_v<Scalar> ? quantum : Scalar(0)), _predictor(predictor), _bytes(_byte_allocator_t(allocator)),
+          _offsets(_offset_allocator_t(allocator)), _pending(_vector_allocator_t(allocator))
+    {
+        _bytes.resize(_padding, 0);
+    }
+
+    /// @brief Appends a vector
+    void push_back(const vector_t& value)
+    {
+        _pending.push_back(value);
+
+        if (_pending.size() == block_size)
+        {
+            _encode(_pending.data());
+            _pending.clear();
+        }
+    }
+
+    /// @brief Appends an array of vectors
+    void append(const vector_t* values, const size_t count)
+    {
+        size_t i = 0;
+
+        // whole blocks are encoded from the input without going through the pending block
+        for (; i < count && !_pending.empty(); i++)
+            push_back(values[i]);
+        for (; i + block_size <= count; i += block_size)
+            _encode(values + i);
+        for (; i < count; i++)
+            push_back(values[i]);
+    }
+
+    /// @brief Decodes the vectors [first, first + count) to `out`
+    /// @param threads The number of threads decoding blocks, 0 for `default_thread_count()`
+    void decode(const size_t first, const size_t count, vector_t* out, const size_t threads = 1) const
+    {
+        if (count == 0)
+            return;
+
+        const size_t first_block = first / block_size;
+        const size_t last_block = (first + count - 1) / block_size;
+
+        parallel_for(last_block - first_block + 1, 1, threads, [&](const size_t begin, const size_t end, size_t)
+        {
+            for (size_t b = first_block + begin; b < first_block + end; b++)
+            {
+                const size_t lo = std::max(b * block_size, first);
+                const size_t hi = std::min((b + 1) * block_size, first + count);
+
+                if (b == _offsets.size())
+                    std::copy(_pending.begin() + (lo - b * block_size), _pending.begin() + (hi - b * block_size), out + (lo - first));
+                else if (hi - lo == block_size)
+                    _decode(b, out + (lo - first));
+                else
+                {
+                    vector_t block[block_size];
+
+                    _decode(b, block);
+                    std::copy(block + (lo - b * block_size), block + (hi - b * block_size), out + (lo - first));
+                }
+            }
+        });
+    }
+
+    /// @brief Decodes all vectors to `out`
+    /// @param threads The number of threads decoding blocks, 0 for `default_thread_count()`
+    void decode(vector_t* out, const size_t threads = 1) const
+    {
+        decode(0, size(), out, threads);
+    }
+
+    /// @brief Decodes a single vector
+    /// @details Decodes its whole block: prefer `decode` for ranges
+    vector_t get(const size_t i) const
+    {
+        vector_t out;
+
+        decode(i, 1, &out);
+        return out;
+    }
+
+    /// @brief Removes all vectors
+    void clear()
+    {
+        _bytes.assign(_padding, 0);
+        _offsets.clear();
+        _pending.clear();
+    }
+
+    /// @brief Gets the number of vectors
+    size_t size() const noexcept
+    {
+        return _offsets.size() * block_size + _pending.size();
+    }
+
+    /// @brief Gets the number of compressed blocks, not counting the incomplete last block
+    size_t block_count() const noexcept
+    {
+        return _offsets.size();
+    }
+
+    /// @brief Gets the number of bytes of the compressed blocks and their index, and of the
+    ///        uncompressed last block
+    size_t bytes() const noexcept
+    {
+        return _bytes.size() - _padding + _offsets.size() * sizeof(uint64_t) + _pending.size() * sizeof(vector_t);
+    }
+
+    /// @brief Gets the step to which components are rounded, 0 if they are stored exactly
+    Scalar quantum() const noexcept
+    {
+        return _quantum;
+    }
+
+private:
+    using _byte_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>;
+    using _offset_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>;
+    using _vector_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<vector_t>;
+    using _bits_t = std::conditional_t<sizeof(Scalar) == 8, uint64_t, std::conditional_t<sizeof(Scalar) == 4, uint32_t,
+                    std::conditional_t<sizeof(Scalar) == 2, uint16_t, uint8_t>>>;
+
+    // zero bytes after the data, so that unpacking can always load 8 bytes and one more
+    static constexpr size_t _padding = 9;
+
+    // the header of a block: the first value of each component, then its first difference, which
+    // would otherwise set the width of the residuals of the linear predictor, then that width
+    static constexpr size_t _header = Size * (2 * sizeof(uint64_t) + 1);
+
+    // the number of residuals of a component in a block
+    static constexpr size_t _residuals = block_size - 2;
+
+    // maps a component to the integer which is predicted, with wrapping arithmetic
+    uint64_t _to_integer(const Scalar value) const noexcept
+    {
+        if constexpr(std::is_integral_v<Scalar>)
+            return uint64_t(int64_t(value));
+        else
+        {
+            if (_quantum > 0)
+                return uint64_t(std::llround(value / _quantum));
+
+            _bits_t bits;
+            std::memcpy(&bits, &value, sizeof(Scalar));
+            return bits;
+        }
+    }
+
+    Scalar _from_integer(const uint64_t value) const noexcept
+    {
+        if constexpr(std::is_integral_v<Scalar>)
+            return Scalar(int64_t(value));
+        else
+        {
+            if (_quantum > 0)
+                return Scalar(int64_t(value)) * _quantum;
+
+            const _bits_t bits = _bits_t(value);
+            Scalar out;
+            std::memcpy(&out, &bits, sizeof(Scalar));
+            return out;
+        }
+    }
+
+    void _encode(const vector_t* values)
+    {
+        const size_t offset = _bytes.size() - _padding;
+        uint64_t residuals[Size][block_size];
+        uint8_t widths[Size];
+
+        _bytes.resize(offset + _header);
+
+        for (size_t c = 0; c < Size; c++)
+        {
+            uint64_t previous = _to_integer(values[0][c]), previous_delta = 0, any = 0;
+
+            std::memcpy(&_bytes[offset + c * sizeof(uint64_t)], &previous, sizeof(uint64_t));
+
+            for (size_t t = 1; t < block_size; t++)
+            {
+                const uint64_t value = _to_integer(values[t][c]);
+                const uint64_t delta = value - previous;
+                const uint64_t residual = _predictor == trajectory_predictor::linear ? delta - previous_delta : delta;
+
+                if (t == 1)
+                    std::memcpy(&_bytes[offset + (Size + c) * sizeof(uint64_t)], &delta, sizeof(uint64_t));
+                else
+                {
+                    residuals[c][t] = residual << 1 ^ uint64_t(int64_t(residual) >> 63);
+                    any |= residuals[c][t];
+                }
+                previous = value;
+                previous_delta = delta;
+            }
+
+            widths[c] = 0;
+
+            while (widths[c] < 64 && any >> widths[c])
+                widths[c]++;
+            _bytes[offset + 2 * Size * sizeof(uint64_t) + c] = widths[c];
+        }
+
+        for (size_t c = 0; c < Size; c++)
+        {
+            const size_t begin = _bytes.size();
+            _bytes.resize(begin + (_residuals * widths[c] + 7) / 8, 0);
+
+            for (size_t t = 2; t < block_size; t++)
+            {
+                const size_t bit = (t - 2) * widths[c];
+
+                for (size_t b = 0; b < widths[c]; b += 8 - (bit + b) % 8)
+                    _bytes[begin + (bit + b) / 8] |= uint8_t(residuals[c][t] >> b << (bit + b) % 8);
+            }
+        }
+
+        _bytes.resize(_bytes.size() + _padding, 0);
+        _offsets.push_back(offset);
+    }
+
+    void _decode(const size_t block, vector_t* out) const
+    {
+        const uint8_t* data = &_bytes[_offsets[block]];
+        const uint8_t* packed = data + _header;
+        uint64_t values[block_size];
+
+        for (size_t c = 0; c < Size; c++)
+        {
+            const size_t width = data[2 * Size * sizeof(uint64_t) + c];
+            const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+
+            std::memcpy(&values[0], data + c * sizeof(uint64_t), sizeof(uint64_t));
+            std::memcpy(&values[1], data + (Size + c) * sizeof(uint64_t), sizeof(uint64_t));
+
+            // unpacks the residuals with unaligned loads; widths over 56 bits may span 9 bytes
+            if (width <= 56)
+            {
+                for (size_t t = 2; t < block_size; t++)
+                {
+                    const size_t bit = (t - 2) * width;
+                    uint64_t word;
+
+                    std::memcpy(&word, packed + bit / 8, sizeof(uint64_t));
+                    values[t] = word >> bit % 8 & mask;
+                }
+            }
+            else
+            {
+                for (size_t t = 2; t < block_size; t++)
+                {
+                    const size_t bit = (t - 2) * width;
+                    uint64_t word;
+
+                    std::memcpy(&word, packed + bit / 8, sizeof(uint64_t));
+                    word = bit % 8 ? word >> bit % 8 | uint64_t(packed[bit / 8 + 8]) << (64 - bit % 8) : word;
+                    values[t] = word & mask;
+                }
+            }
+            packed += (_residuals * width + 7) / 8;
+
+            for (size_t t = 2; t < block_size; t++)
+                values[t] = values[t] >> 1 ^ (uint64_t(0) - (values[t] & 1));
+
+            // the prefix sums undo the differences: once for delta, twice for linear
+            if (_predictor == trajectory_predictor::linear)
+            {
+                for (size_t t = 2; t < block_size; t++)
+                    values[t] += values[t - 1];
+            }
+            for (size_t t = 1; t < block_size; t++)
+                values[t] += values[t - 1];
+
+            for (size_t t = 0; t < block_size; t++)
+                out[t][c] = _from_integer(values[t]);
+        }
+    }
+
+    Scalar _quantum;
+    trajectory_predictor _predictor;
+
+    // the blocks one after another, followed by the padding
+    std::vector<uint8_t, _byte_allocator_t> _bytes;
+
+    // the offset of each block in `_bytes`
+    std::vector<uint64_t, _offset_allocator_t> _offsets;
+
+    // the last block, until it is complete
+    std::vector<vector_t, _vector_allocator_t> _pending;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,328 @@
+#pragma once
+#include "parallel.h"
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+_DD_NAMESPACE_OPEN
+
+
+namespace impl
+{
+    // the index of the lowest set bit of a non-zero word, by de Bruijn multiplication
+    constexpr size_t _lowest_bit(const uint64_t word) noexcept
+    {
+        constexpr uint8_t table[64] = {
+             0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+            62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+            63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+            46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6,
+        };
+        return table[((word & (~word + 1)) * 0x03F79D71B4CB0A89ull) >> 58];
+    }
+}
+
+/// @brief A sparse volume of voxels stored in bricks
+/// @details The volume is divided into bricks of `2^Log2` voxels along each axis. Only bricks
+///          containing active voxels are stored: contiguously, each with a bitmask of its active
+///          voxels and a dense array of values, and found through a hash map from brick coordinates.
+///          Inactive voxels read as the background value.
+///
+///          Compared to a hash map of voxels this allocates once per brick rather than per voxel, and
+///          keeps neighbouring voxels adjacent in memory. Iteration walks the bricks in order and the
+///          set bits of their masks, and can be split across threads by brick. Bricks are not freed
+///          when their voxels are erased until `prune()` is called
+/// @param T The type of the voxel values
+/// @param Log2 The base 2 logarithm of the edge length of the bricks, from 2 to 5
+/// @param Allocator Allocator for the internal arrays, rebound to the element types
+template<class T, size_t Log2 = 3, class Allocator = std::allocator<T>>
+class voxel_grid
+{
+public:
+    static_assert(Log2 >= 2 && Log2 <= 5, "Bricks have to be from 4 to 32 voxels wide");
+
+    using value_t = T;
+
+    /// @brief The number of voxels along each axis of a brick
+    static constexpr int32_t brick_size = int32_t(1) << Log2;
+
+    /// @brief The number of voxels in a brick
+    static constexpr size_t brick_volume = size_t(1) << (3 * Log2);
+
+    /// @param background The value of inactive voxels
+    explicit voxel_grid(const T& background = T(), const Allocator& allocator = Allocator())
+        : _background(background), _bricks(0, std::hash<int3d>(), std::equal_to<int3d>(), _map_allocator_t(allocator)),
+          _origins(_origin_allocator_t(allocator)), _masks(_word_allocator_t(allocator)), _values(allocator)
+    {}
+
+    /// @brief Sets the value of a voxel, activating it
+    void set(const int3d& voxel, const T& value)
+    {
+        const size_t brick = _find_or_add(_brick_of(voxel));
+        const size_t offset = _offset(voxel, brick);
+        uint64_t& word = _masks[brick * _words + offset / 64];
+
+        _active += !(word >> (offset % 64) & 1);
+        word |= uint64_t(1) << (offset % 64);
+        _values[brick * brick_volume + offset] = value;
+    }
+
+    /// @brief Deactivates a voxel, resetting it to the background value
+    /// @return Whether the voxel was active
+    bool erase(const int3d& voxel)
+    {
+        const auto it = _bricks.find(_brick_of(voxel));
+
+        if (it == _bricks.end())
+            return false;
+
+        const size_t offset = _offset(voxel, it->second);
+        uint64_t& word = _masks[it->second * _words + offset / 64];
+        const bool was_active = word >> (offset % 64) & 1;
+
+        word &= ~(uint64_t(1) << (offset % 64));
+        _values[it->second * brick_volume + offset] = _background;
+        _active -= was_active;
+        return was_active;
+    }
+
+    /// @brief Gets the value of a voxel, or the background value if it is inactive
+    const T& get(const int3d& voxel) const
+    {
+        const T* value = find(voxel);
+        return value ? *value : _background;
+    }
+
+    /// @brief Gets a pointer to the value of an active voxel, or null if it is inactive
+    T* find(const int3d& voxel)
+    {
+        return const_cast<T*>(std::as_const(*this).find(voxel));
+    }
+
+    /// @brief Gets a pointer to the value of an active voxel, or null if it is inactive
+    const T* find(const int3d& voxel) const
+    {
+        const auto it = _bricks.find(_brick_of(voxel));
+        return it == _bricks.end() ? nullptr : _find(voxel, it->second);
+    }
+
+    /// @brief Checks whether a voxel is active
+    bool active(const int3d& voxel) const
+    {
+        return find(voxel) != nullptr;
+    }
+
+    /// @brief Calls `fn(voxel, value)` for each active voxel
+    /// @details Bricks are visited in the order they were created and the voxels of a brick with x
+    ///          varying fastest. With several threads, each brick is visited by a single thread
+    /// @param threads The number of threads, 0 for `default_thread_count()`
+    template<class Fn>
+    void for_each(const Fn& fn, const size_t threads = 1)
+    {
+        _for_each(*this, fn, threads);
+    }
+
+    /// @copydoc for_each
+    template<class Fn>
+    void for_each(const Fn& fn, const size_t threads = 1) const
+    {
+        _for_each(*this, fn, threads);
+    }
+
+    /// @brief Calls `fn(origin, mask, values)` for each brick
+    /// @details `origin` is the voxel at the lowest corner of the brick, `mask` the `brick_volume / 64`
+    ///          words with bit `i % 64` of word `i / 64` set when voxel `i` is active, and `values` the
+    ///          `brick_volume` values, with voxel `origin + (x, y, z)` at index
+    ///          `x + brick_size * (y + brick_size * z)`
+    /// @param threads The number of threads, 0 for `default_thread_count()`
+    template<class Fn>
+    void for_each_brick(const Fn& fn, const size_t threads = 1)
+    {
+        parallel_for(_origins.size(), _brick_grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            for (size_t b = first; b < last; b++)
+                fn(_origins[b], &_masks[b * _words], &_values[b * brick_volume]);
+        });
+    }
+
+    /// @brief Frees the bricks without active voxels
+    /// @details Moves the remaining bricks, invalidating pointers to values
+    void prune()
+    {
+        size_t kept = 0;
+
+        for (size_t b = 0; b < _origins.size(); b++)
+        {
+            bool empty = true;
+
+            for (size_t w = 0; w < _words; w++)
+                empty &= _masks[b * _words + w] == 0;
+
+            if (empty)
+            {
+                _bricks.erase(_brick_of(_origins[b]));
+                continue;
+            }
+            if (kept != b)
+            {
+                _origins[kept] = _origins[b];
+                _bricks[_brick_of(_origins[kept])] = kept;
+                std::copy_n(_masks.begin() + b * _words, _words, _masks.begin() + kept * _words);
+                std::move(_values.begin() + b * brick_volume, _values.begin() + (b + 1) * brick_volume, _values.begin() + kept * brick_volume);
+            }
+            kept++;
+        }
+        _origins.resize(kept);
+        _masks.resize(kept * _words);
+        _values.resize(kept * brick_volume, _background);
+    }
+
+    /// @brief Removes all voxels
+    void clear()
+    {
+        _bricks.clear();
+        _origins.clear();
+        _masks.clear();
+        _values.clear();
+        _active = 0;
+    }
+
+    /// @brief Gets the number of active voxels
+    size_t size() const noexcept
+    {
+        return _active;
+    }
+
+    /// @brief Gets the number of allocated bricks
+    size_t brick_count() const noexcept
+    {
+        return _origins.size();
+    }
+
+    /// @brief Gets the value of inactive voxels
+    const T& background() const noexcept
+    {
+        return _background;
+    }
+
+    /// @brief Reads voxels, remembering the last brick visited
+    /// @details Consecutive reads of nearby voxels, e.g. the neighbours of a voxel in a stencil, mostly
+    ///          fall in the same brick and skip the hash map. Invalidated by adding bricks or `prune()`
+    class accessor
+    {
+    public:
+        explicit accessor(const voxel_grid& grid) noexcept : _grid(&grid) {}
+
+        /// @brief Gets the value of a voxel, or the background value if it is inactive
+        const T& get(const int3d& voxel)
+        {
+            const T* value = find(voxel);
+            return value ? *value : _grid->_background;
+        }
+
+        /// @brief Gets a pointer to the value of an active voxel, or null if it is inactive
+        const T* find(const int3d& voxel)
+        {
+            const int3d brick = _brick_of(voxel);
+
+            if (brick != _brick)
+            {
+                const auto it = _grid->_bricks.find(brick);
+
+                _brick = brick;
+                _index = it == _grid->_bricks.end() ? _none : it->second;
+            }
+            return _index == _none ? nullptr : _grid->_find(voxel, _index);
+        }
+
+    private:
+        static constexpr size_t _none = SIZE_MAX;
+
+        const voxel_grid* _grid;
+        int3d _brick = int3d(INT32_MAX, INT32_MAX, INT32_MAX);
+        size_t _index = _none;
+    };
+
+private:
+    using _map_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const int3d, size_t>>;
+    using _origin_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<int3d>;
+    using _word_allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>;
+
+    // the number of mask words per brick
+    static constexpr size_t _words = brick_volume / 64;
+
+    // the number of bricks claimed at once by a thread
+    static constexpr size_t _brick_grain = 16;
+
+    // the brick containing a voxel, rounding towards negative infinity
+    static int3d _brick_of(const int3d& voxel) noexcept
+    {
+        int3d out;
+
+        for (size_t c = 0; c < 3; c++)
+            out[c] = voxel[c] < 0 ? ~(~voxel[c] >> Log2) : voxel[c] >> Log2;
+        return out;
+    }
+
+    // the index of a voxel within its brick
+    size_t _offset(const int3d& voxel, const size_t brick) const noexcept
+    {
+        const int3d local = voxel - _origins[brick];
+        return size_t(local.x + brick_size * (local.y + brick_size * local.z));
+    }
+
+    const T* _find(const int3d& voxel, const size_t brick) const noexcept
+    {
+        const size_t offset = _offset(voxel, brick);
+        const bool is_active = _masks[brick * _words + offset / 64] >> (offset % 64) & 1;
+
+        return is_active ? &_values[brick * brick_volume + offset] : nullptr;
+    }
+
+    size_t _find_or_add(const int3d& brick)
+    {
+        const auto [it, added] = _bricks.try_emplace(brick, _origins.size());
+
+        if (added)
+        {
+            _origins.push_back(brick * brick_size);
+            _masks.resize(_masks.size() + _words, 0);
+            _values.resize(_values.size() + brick_volume, _background);
+        }
+        return it->second;
+    }
+
+    template<class Self, class Fn>
+    static void _for_each(Self& self, const Fn& fn, const size_t threads)
+    {
+        parallel_for(self._origins.size(), _brick_grain, threads, [&](const size_t first, const size_t last, size_t)
+        {
+            for (size_t b = first; b < last; b++)
+            {
+                for (size_t w = 0; w < _words; w++)
+                {
+                    // visit the set bits of the word, lowest first
+                    for (uint64_t word = self._masks[b * _words + w]; word; word &= word - 1)
+                    {
+                        const size_t offset = w * 64 + impl::_lowest_bit(word);
+                        const int3d local(int32_t(offset % brick_size), int32_t(offset / brick_size % brick_size), int32_t(offset / brick_size / brick_size));
+                        const int3d voxel = self._origins[b] + local;
+
+                        fn(voxel, self._values[b * brick_volume + offset]);
+                    }
+                }
+            }
+        });
+    }
+
+    T _background;
+    std::unordered_map<int3d, size_t, std::hash<int3d>, std::equal_to<int3d>, _map_allocator_t> _bricks;
+    std::vector<int3d, _origin_allocator_t> _origins;
+    std::vector<uint64_t, _word_allocator_t> _masks;
+    std::vector<T, Allocator> _values;
+    size_t _active = 0;
+};
+
+
+_DD_NAMESPACE_CLOSE
@@ -0,0 +1,209 @@
+// C++20 module interface of dandy. `import dandy;` provides the same API as including
+// <dandy/dandy.h>; the header remains the implementation, so both can be used in one program.
+// Configuration macros such as `DD_FAST_MATH` apply when compiling this interface unit
+module;
+
+#include <dandy/dandy.h>
+
+export module dandy;
+
+export namespace dd
+{
+    using dd::vector;
+    using dd::aligned_vector;
+    using dd::converter;
+    using dd::constant;
+
+    using dd::min;
+    using dd::max;
+    using dd::clamp;
+    using dd::lerp;
+    using dd::slice;
+    using dd::describe;
+
+    using dd::precise;
+    using dd::fast;
+
+    using dd::angles;
+    using dd::from_angles;
+    using dd::delta_angles;
+    using dd::to_polar;
+    using dd::from_polar;
+    using dd::to_spherical;
+    using dd::from_spherical;
+
+    using dd::bool2d;
+    using dd::char2d;
+    using dd::uchar2d;
+    using dd::int2d;
+    using dd::uint2d;
+    using dd::long2d;
+    using dd::ulong2d;
+    using dd::float2d;
+    using dd::double2d;
+
+    using dd::bool3d;
+    using dd::char3d;
+    using dd::uchar3d;
+    using dd::int3d;
+    using dd::uint3d;
+    using dd::long3d;
+    using dd::ulong3d;
+    using dd::float3d;
+    using dd::double3d;
+
+    using dd::bool4d;
+    using dd::char4d;
+    using dd::uchar4d;
+    using dd::int4d;
+    using dd::uint4d;
+    using dd::long4d;
+    using dd::ulong4d;
+    using dd::float4d;
+    using dd::double4d;
+}
+
+export namespace dd::types
+{
+    using dd::types::bool2d;
+    using dd::types::char2d;
+    using dd::types::uchar2d;
+    using dd::types::int2d;
+    using dd::types::uint2d;
+    using dd::types::long2d;
+    using dd::types::ulong2d;
+    using dd::types::float2d;
+    using dd::types::double2d;
+
+    using dd::types::bool3d;
+    using dd::types::char3d;
+    using dd::types::uchar3d;
+    using dd::types::int3d;
+    using dd::types::uint3d;
+    using dd::types::long3d;
+    using dd::types::ulong3d;
+    using dd::types::float3d;
+    using dd::types::double3d;
+
+    using dd::types::bool4d;
+    using dd::types::char4d;
+    using dd::types::uchar4d;
+    using dd::types::int4d;
+    using dd::types::uint4d;
+    using dd::types::long4d;
+    using dd::types::ulong4d;
+    using dd::types::float4d;
+    using dd::types::double4d;
+}
+
+export namespace dd::impl
+{
+    using dd::impl::expression_base;
+    using dd::impl::expression;
+    using dd::impl::operation;
+    using dd::impl::view;
+    using dd::impl::value;
+
+    using dd::impl::operator+;
+    using dd::impl::operator-;
+    using dd::impl::operator*;
+    using dd::impl::operator/;
+    using dd::impl::operator%;
+    using dd::impl::operator&;
+    using dd::impl::operator|;
+    using dd::impl::operator^;
+    using dd::impl::operator>>;
+    using dd::impl::operator<<;
+    using dd::impl::operator~;
+
+    using dd::impl::operator+=;
+    using dd::impl::operator-=;
+    using dd::impl::operator*=;
+    using dd::impl::operator/=;
+    using dd::impl::operator%=;
+    using dd::impl::operator&=;
+    using dd::impl::operator|=;
+    using dd::impl::operator^=;
+    using dd::impl::operator>>=;
+    using dd::impl::operator<<=;
+
+    using dd::impl::min;
+    using dd::impl::max;
+    using dd::impl::clamp;
+    using dd::impl::lerp;
+}
+
+export namespace dd::traits
+{
+    using dd::traits::type_identity;
+    using dd::traits::require;
+    using dd::traits::is_value;
+    using dd::traits::is_value_v;
+    using dd::traits::is_operation;
+    using dd::traits::is_operation_v;
+    using dd::traits::is_view;
+    using dd::traits::is_view_v;
+    using dd::traits::is_constant;
+    using dd::traits::is_constant_v;
+    using dd::traits::is_scalar;
+    using dd::traits::is_scalar_v;
+    using dd::traits::is_expression;
+    using dd::traits::is_expression_v;
+    using dd::traits::scalar;
+    using dd::traits::scalar_t;
+    using dd::traits::size;
+    using dd::traits::size_v;
+    using dd::traits::capacity;
+    using dd::traits::capacity_v;
+    using dd::traits::vector;
+    using dd::traits::vector_t;
+    using dd::traits::is_same_size;
+    using dd::traits::is_same_size_v;
+    using dd::traits::is_valid_operation;
+    using dd::traits::is_valid_operation_v;
+    using dd::traits::has_converter;
+    using dd::traits::has_converter_v;
+    using dd::traits::expression_cost;
+    using dd::traits::cost;
+    using dd::traits::cost_v;
+}
+
+export namespace dd::math
+{
+    using dd::math::real_t;
+    using dd::math::precise_t;
+    using dd::math::fast_t;
+    using dd::math::precise;
+    using dd::math::fast;
+    using dd::math::is_policy_v;
+
+    using dd::math::sqrt;
+    using dd::math::exp;
+    using dd::math::sincos;
+    using dd::math::sin;
+    using dd::math::cos;
+    using dd::math::atan2;
+    using dd::math::acos;
+}
+
+#ifdef DD_INSTRUMENT
+export namespace dd::instrument
+{
+    using dd::instrument::event;
+    using dd::instrument::counters;
+    using dd::instrument::callback_t;
+    using dd::instrument::type_name;
+    using dd::instrument::set_callback;
+    using dd::instrument::get;
+    using dd::instrument::snapshot;
+    using dd::instrument::reset;
+}
+#endif
+
+// `std::operator<<` for vector expressions is declared in the global module fragment and would not
+// be found by importers; exporting it from the namespace of the expressions makes it found by
+// argument-dependent lookup, e.g. for `std::cout << v`
+export namespace dd::impl
+{
+    using std::operator<<;
+}
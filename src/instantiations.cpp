@@ -0,0 +1,3 @@
+// Instantiates the vector types of `dd::types` once, for builds defining `DD_EXTERN_TEMPLATES`
+#define DD_INSTANTIATE_TEMPLATES
+#include <dandy/dandy.h>
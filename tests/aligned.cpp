@@ -0,0 +1,62 @@
+#include "common.h"
+#include <unordered_set>
+
+TEST(Aligned, Layout)
+{
+    EXPECT_EQ(sizeof(aligned_vector<float, 3>), 16);
+    EXPECT_EQ(alignof(aligned_vector<float, 3>), 16);
+    EXPECT_EQ(sizeof(aligned_vector<double, 3>), 32);
+    EXPECT_EQ(alignof(aligned_vector<double, 3>), 32);
+    EXPECT_EQ(sizeof(aligned_vector<float, 4>), 16);
+    EXPECT_EQ(sizeof(aligned_vector<int32_t, 5>), 32);
+    EXPECT_EQ(sizeof(aligned_vector<float, 3>[4]), 64);
+
+    EXPECT_EQ((aligned_vector<float, 3>::capacity), 4);
+    EXPECT_EQ((traits::capacity_v<aligned_vector<float, 3>>), 4);
+    EXPECT_EQ((traits::capacity_v<float3d>), 3);
+    EXPECT_TRUE((traits::is_value_v<aligned_vector<float, 3>>));
+    EXPECT_TRUE((traits::is_same_size_v<aligned_vector<float, 3>, float3d>));
+}
+
+TEST(Aligned, Padding)
+{
+    aligned_vector<float, 3> a { 1, 2, 3 };
+    aligned_vector<float, 3> b(2);
+    aligned_vector<float, 3> c;
+
+    EXPECT_EQ(a.data[3], 0);
+    EXPECT_EQ(b.data[3], 0);
+    EXPECT_EQ(c.data[3], 0);
+    EXPECT_EQ(a.z, 3);
+
+    // the padding lane would be NaN if it was left as evaluated
+    c = a / c + b * 2 + 1;
+
+    EXPECT_EQ(c.data[3], 0);
+    EXPECT_EQ(c[2], std::numeric_limits<float>::infinity());
+
+    aligned_vector<int32_t, 3> d { 1, 2, 3 };
+    d = d / d;
+
+    EXPECT_EQ(d, int3d(1, 1, 1));
+    EXPECT_EQ(d.data[3], 0);
+}
+
+TEST(Aligned, Interoperability)
+{
+    float3d a { 1, 2, 3 };
+    aligned_vector<float, 3> b = a;
+    aligned_vector<float, 3> c = a + b;
+
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(c, float3d(2, 4, 6));
+    EXPECT_EQ(c.data[3], 0);
+    testing::StaticAssertTypeEq<decltype((a + b).evaluate()), float3d>();
+
+    a = c - b;
+
+    EXPECT_EQ(a, float3d(1, 2, 3));
+    EXPECT_DOUBLE_EQ(b.length(), a.length());
+    EXPECT_EQ(b.to_string(), a.to_string());
+    EXPECT_EQ((std::hash<aligned_vector<float, 3>>()(b)), std::hash<float3d>()(a));
+}
@@ -0,0 +1,82 @@
+#include "common.h"
+#include <dandy/atomic.h>
+#include <thread>
+
+template<class Fn>
+static void run_threads(const size_t threads, const Fn& fn)
+{
+    std::vector<std::thread> pool;
+
+    for (size_t t = 0; t < threads; t++)
+        pool.emplace_back(fn, t);
+    for (std::thread& thread : pool)
+        thread.join();
+}
+
+TEST(Atomic, Vector)
+{
+    atomic_vector<double, 3> a;
+    atomic_vector<int32_t, 3> b(int3d(1, 2, 3));
+
+    EXPECT_EQ(a.load(), double3d::zero);
+    EXPECT_EQ(b.load(), int3d(1, 2, 3));
+
+    EXPECT_EQ(b.fetch_add(int3d(1, 1, 1) * 2), int3d(1, 2, 3));
+    EXPECT_EQ(b.load(), int3d(3, 4, 5));
+
+    b -= int3d(3, 4, 5);
+    a += double3d(1, 2, 3) * 0.5;
+
+    EXPECT_EQ(b.load(), int3d::zero);
+    EXPECT_EQ(double3d(a), double3d(0.5, 1, 1.5));
+}
+
+TEST(Atomic, Contention)
+{
+    constexpr size_t threads = 4;
+    constexpr size_t additions = 10000;
+
+    atomic_vector<double, 3> a;
+    atomic_vector<int64_t, 2> b;
+
+    run_threads(threads, [&](const size_t t)
+    {
+        for (size_t i = 0; i < additions; i++)
+        {
+            a += double3d(1, 0.5, t);
+            b.fetch_add(long2d(1, -1), std::memory_order_relaxed);
+        }
+    });
+
+    EXPECT_EQ(a.load(), double3d(threads * additions, threads * additions * 0.5, additions * 6));
+    EXPECT_EQ(b.load(), long2d(threads * additions, -int64_t(threads * additions)));
+}
+
+TEST(Atomic, ReductionBuffer)
+{
+    constexpr size_t threads = 4;
+    constexpr size_t slots = 7;
+
+    reduction_buffer<double, 3> buffer(slots, threads);
+    std::vector<double3d> out(slots, double3d(1));
+
+    run_threads(threads, [&](const size_t t)
+    {
+        double3d* local = buffer.local(t);
+
+        for (size_t i = 0; i < 1000; i++)
+            local[i % slots] += double3d(1, t, i % slots);
+    });
+    buffer.reduce(out.data());
+
+    size_t count[slots] = {};
+
+    for (size_t i = 0; i < 1000; i++)
+        count[i % slots]++;
+
+    for (size_t s = 0; s < slots; s++)
+        EXPECT_EQ(out[s], 1 + double3d(threads, 6, threads * s) * count[s]);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.local(threads - 1)[slots - 1], double3d::zero);
+}
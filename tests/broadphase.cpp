@@ -0,0 +1,90 @@
+#include "common.h"
+#include <dandy/broadphase.h>
+#include <dandy/memory.h>
+
+using pair_list = std::vector<std::pair<uint32_t, uint32_t>>;
+
+static pair_list brute_force(const std::vector<aabb<float, 3>>& boxes)
+{
+    pair_list out;
+
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+        for (uint32_t j = i + 1; j < boxes.size(); j++)
+        {
+            if (boxes[i].overlaps(boxes[j]))
+                out.emplace_back(i, j);
+        }
+    }
+    return out;
+}
+
+TEST(Broadphase, Box)
+{
+    const aabb<float, 2> a { { 0, 0 }, { 1, 1 } }, b { { 1, 0.5f }, { 2, 2 } }, c { { 0.5f, 1.5f }, { 1, 2 } };
+
+    EXPECT_TRUE(a.overlaps(b) && b.overlaps(a));
+    EXPECT_TRUE(b.overlaps(c));
+    EXPECT_FALSE(a.overlaps(c));
+}
+
+TEST(Broadphase, SweepAndPrune)
+{
+    constexpr size_t count = 3000;
+    std::vector<aabb<float, 3>> boxes(count);
+    std::vector<float3d> velocities(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        boxes[i].lo = random_vector<float3d>() * 20.f;
+        boxes[i].hi = boxes[i].lo + random_vector<float3d>();
+        velocities[i] = random_vector<float3d>() - 0.5f;
+    }
+
+    sweep_and_prune<float, 3> broadphase(1);
+    pair_list pairs, threaded;
+
+    // the order is carried across frames of moving boxes, and the pairs do not depend on the thread count
+    for (size_t frame = 0; frame < 5; frame++)
+    {
+        broadphase.update(boxes.data(), count);
+        pairs.clear();
+        threaded.clear();
+        broadphase.find_pairs(pairs);
+        broadphase.find_pairs(threaded, 4);
+
+        EXPECT_EQ(pairs, threaded);
+        std::sort(pairs.begin(), pairs.end());
+        EXPECT_EQ(pairs, brute_force(boxes));
+
+        for (size_t i = 0; i < count; i++)
+        {
+            boxes[i].lo += velocities[i];
+            boxes[i].hi += velocities[i];
+        }
+    }
+
+    // a change in the number of boxes sorts anew
+    boxes.resize(count / 2);
+    broadphase.update(boxes.data(), boxes.size());
+    pairs.clear();
+    broadphase.find_pairs(pairs, 0);
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(pairs, brute_force(boxes));
+
+    arena memory(1 << 16);
+    sweep_and_prune<float, 3, arena_allocator<float>> allocated(0, arena_allocator<float>(memory));
+    allocated.update(boxes.data(), boxes.size());
+    pairs.clear();
+    allocated.find_pairs(pairs);
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(pairs, brute_force(boxes));
+
+    // the pairs of each chunk are allocated from the arena as well
+    const size_t allocations = memory.stats().allocation_count;
+    threaded.clear();
+    allocated.find_pairs(threaded, 4);
+    std::sort(threaded.begin(), threaded.end());
+    EXPECT_EQ(threaded, pairs);
+    EXPECT_GT(memory.stats().allocation_count, allocations);
+}
@@ -31,7 +31,7 @@ TYPED_TEST(ConversionsAll, Array_conversion)
     vector_t vec = random_vector<vector_t>();
 
     // cast result to avoid type-promotion issues when multiplying a char
-    std::array<scalar_t, size> arr = (2 * vec).scalar_cast<scalar_t>();
+    std::array<scalar_t, size> arr = (2 * vec).template scalar_cast<scalar_t>();
 
     for (size_t i = 0; i < size; i++)
         EXPECT_EQ(arr[i], (scalar_t)(2 * vec[i]));
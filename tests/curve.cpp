@@ -0,0 +1,182 @@
+#include "common.h"
+#include <dandy/curve.h>
+#include <dandy/memory.h>
+#include <cmath>
+
+// de Casteljau's algorithm with lerps
+static double2d reference_bezier(const cubic_bezier<double, 2>& curve, const double t)
+{
+    const double2d a(curve.points[0].lerp(curve.points[1], t)), b(curve.points[1].lerp(curve.points[2], t)), c(curve.points[2].lerp(curve.points[3], t));
+    const double2d ab(a.lerp(b, t)), bc(b.lerp(c, t));
+
+    return double2d(ab.lerp(bc, t));
+}
+
+TEST(Curve, Bezier)
+{
+    const cubic_bezier<double, 2> curve{ { double2d(0, 0), double2d(1, 2), double2d(3, 2), double2d(4, 0) } };
+
+    EXPECT_EQ(curve(0), curve.points[0]);
+    EXPECT_EQ(curve(1), curve.points[3]);
+
+    std::vector<double> t(1000);
+    std::vector<double2d> points(t.size());
+
+    for (size_t i = 0; i < t.size(); i++)
+        t[i] = double(i) / double(t.size() - 1);
+    curve.evaluate(t.data(), t.size(), points.data(), 3);
+
+    for (size_t i = 0; i < t.size(); i++)
+    {
+        EXPECT_LT(points[i].distance(reference_bezier(curve, t[i])), 1e-12);
+        EXPECT_EQ(points[i], curve(t[i]));
+
+        // central differences
+        const double h = 1e-6;
+        EXPECT_LT(curve.derivative(t[i]).distance((curve(t[i] + h) - curve(t[i] - h)) / (2 * h)), 1e-6);
+    }
+
+    const auto [left, right] = curve.split(0.3);
+
+    EXPECT_LT(left(0.5).distance(curve(0.15)), 1e-12);
+    EXPECT_LT(right(0.5).distance(curve(0.65)), 1e-12);
+}
+
+TEST(Curve, CatmullRom)
+{
+    const float2d points[] = { float2d(0, 0), float2d(1, 1), float2d(2, 0), float2d(3, 1), float2d(5, 0) };
+    const catmull_rom_spline<float, 2> spline(points, 5);
+
+    EXPECT_EQ(spline.segment_count(), 4u);
+    EXPECT_EQ(spline.domain(), 4.f);
+
+    // the spline passes through the points, with tangents from the neighbouring points
+    for (size_t i = 0; i < 5; i++)
+        EXPECT_LT(spline(float(i)).distance(points[i]), 1e-6);
+    EXPECT_LT(spline.derivative(2).distance((points[3] - points[1]) * 0.5f), 1e-6);
+    EXPECT_EQ(spline(-1), points[0]);
+    EXPECT_EQ(spline(10), points[4]);
+
+    std::vector<float> t(2000);
+    std::vector<float2d> out(t.size());
+
+    for (size_t i = 0; i < t.size(); i++)
+        t[i] = float(i) * 0.0025f - 0.5f;
+    spline.evaluate(t.data(), t.size(), out.data(), 2);
+
+    for (size_t i = 0; i < t.size(); i++)
+        EXPECT_LT(out[i].distance(spline(t[i])), 1e-5);
+}
+
+TEST(Curve, CatmullRomDegenerate)
+{
+    const float t[] = { -1.f, 0.f, 0.5f, 2.f };
+    float2d out[4];
+
+    catmull_rom_spline<float, 2> spline;
+
+    EXPECT_EQ(spline(0.5f), float2d::zero);
+    EXPECT_EQ(spline.derivative(0.5f), float2d::zero);
+    spline.evaluate(t, 4, out);
+
+    for (const float2d& p : out)
+        EXPECT_EQ(p, float2d::zero);
+
+    spline.push_back(float2d(3, 4));
+    ASSERT_EQ(spline.size(), 1);
+    EXPECT_EQ(spline.domain(), 0);
+    spline.evaluate(t, 4, out);
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(spline(t[i]), float2d(3, 4));
+        EXPECT_EQ(spline.derivative(t[i]), float2d::zero);
+        EXPECT_EQ(out[i], float2d(3, 4));
+    }
+
+    const float2d point(5, 6);
+    const catmull_rom_spline<float, 2> single(&point, 1);
+
+    EXPECT_EQ(single(1.f), point);
+    EXPECT_EQ(single.derivative(1.f), float2d::zero);
+}
+
+TEST(Curve, CatmullRomAllocator)
+{
+    const float2d points[] = { float2d(0, 0), float2d(1, 1), float2d(2, 0), float2d(3, 1) };
+    const catmull_rom_spline<float, 2> reference(points, 4);
+
+    arena scratch;
+    catmull_rom_spline<float, 2, arena_allocator<float2d>> spline(scratch);
+
+    for (const float2d& p : points)
+        spline.push_back(p);
+
+    EXPECT_EQ(spline.size(), 4u);
+    EXPECT_EQ(spline.points()[3], points[3]);
+
+    std::vector<float> t(100);
+    std::vector<float2d> out(t.size());
+
+    for (size_t i = 0; i < t.size(); i++)
+        t[i] = float(i) * 0.04f - 0.5f;
+
+    // the control points are drawn from the arena once, not on every evaluation
+    const size_t allocations = scratch.stats().allocation_count;
+    spline.evaluate(t.data(), t.size(), out.data());
+    EXPECT_EQ(scratch.stats().allocation_count, allocations);
+
+    for (size_t i = 0; i < t.size(); i++)
+    {
+        EXPECT_LT(out[i].distance(reference(t[i])), 1e-6);
+        EXPECT_EQ(spline(t[i]), reference(t[i]));
+    }
+}
+
+TEST(Curve, ArcLength)
+{
+    // a quarter circle of radius 1, approximated by a Bézier curve
+    const double k = 0.5522847498;
+    const cubic_bezier<double, 2> curve{ { double2d(1, 0), double2d(1, k), double2d(k, 1), double2d(0, 1) } };
+    const arc_length_table<double> table(curve, 1024);
+
+    EXPECT_NEAR(table.length(), std::acos(-1.0) / 2, 1e-3);
+    EXPECT_EQ(table.parameter(0), 0);
+    EXPECT_EQ(table.parameter(table.length()), 1);
+    EXPECT_EQ(table.parameter(-1), 0);
+    EXPECT_EQ(table.parameter(10), 1);
+
+    // evenly spaced points are at even angles
+    std::vector<double> t(91);
+    std::vector<double2d> points(t.size());
+
+    table.uniform_parameters(t.data(), t.size());
+    curve.evaluate(t.data(), t.size(), points.data());
+
+    for (size_t i = 1; i < t.size(); i++)
+    {
+        EXPECT_NEAR(points[i].distance(points[i - 1]), points[1].distance(points[0]), 1e-5);
+        EXPECT_EQ(t[i], table.parameter(table.length() * double(i) / 90));
+    }
+
+    // splines, whose parameters are far from uniform when the points are unevenly spaced
+    const double3d controls[] = { double3d(0, 0, 0), double3d(1, 0, 0), double3d(5, 0, 0), double3d(5, 5, 0) };
+    const catmull_rom_spline<double, 3> spline(controls, 4);
+    const arc_length_table<double> spline_table(spline, 4096);
+
+    std::vector<double> spline_t(200);
+    std::vector<double3d> spline_points(spline_t.size());
+
+    spline_table.uniform_parameters(spline_t.data(), spline_t.size());
+    spline.evaluate(spline_t.data(), spline_t.size(), spline_points.data());
+
+    const double spacing = spline_table.length() / 199;
+
+    EXPECT_GT(spline_table.length(), 10);
+
+    for (size_t i = 1; i < spline_t.size(); i++)
+    {
+        EXPECT_GT(spline_t[i], spline_t[i - 1]);
+        EXPECT_NEAR(spline_points[i].distance(spline_points[i - 1]), spacing, spacing * 0.01);
+    }
+}
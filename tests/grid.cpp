@@ -0,0 +1,81 @@
+#include "common.h"
+#include <dandy/grid.h>
+
+TEST(Grid, Cells)
+{
+    spatial_grid<float, 2> grid(0.5f);
+    const float2d positions[5] = { { 0.1f, 0.1f }, { -0.1f, 0.1f }, { 0.4f, 0.2f }, { 1.2f, -0.7f }, { 0.3f, 0.3f } };
+
+    EXPECT_EQ(grid.cell_of({ -0.1f, 0.1f }), int2d(-1, 0));
+    EXPECT_EQ(grid.cell_of({ 1.2f, -0.7f }), int2d(2, -2));
+
+    grid.build(positions, 5);
+    EXPECT_EQ(grid.size(), 5u);
+    EXPECT_EQ(grid.bucket_count(), 8u);
+
+    // the points of a cell keep their order
+    std::vector<uint32_t> found;
+    grid.for_each_in_cell({ 0, 0 }, [&](const float2d& position, const uint32_t index)
+    {
+        EXPECT_EQ(position, positions[index]);
+        found.push_back(index);
+    });
+    EXPECT_EQ(found, std::vector<uint32_t>({ 0, 2, 4 }));
+
+    found.clear();
+    grid.for_each_in_cell({ 5, 5 }, [&](const float2d&, const uint32_t index) { found.push_back(index); });
+    EXPECT_TRUE(found.empty());
+
+    // any value type
+    const std::string names[2] = { "a", "b" };
+    spatial_grid<float, 2, std::string> named(1.f);
+    named.build(positions, names, 2);
+
+    std::vector<std::string> near;
+    named.find_in_radius({ 0, 0 }, 0.2f, near);
+    std::sort(near.begin(), near.end());
+    EXPECT_EQ(near, std::vector<std::string>({ "a", "b" }));
+
+    spatial_grid<float, 2> empty(1.f);
+    empty.build(positions, 0);
+    empty.find_in_radius({ 0, 0 }, 1.f, found);
+    EXPECT_TRUE(found.empty());
+}
+
+TEST(Grid, Radius)
+{
+    constexpr size_t count = 20000;
+    std::vector<double3d> positions(count);
+
+    for (double3d& p : positions)
+        p = (random_vector<double3d>() - 0.5) * 10.0;
+
+    spatial_grid<double, 3> grid(0.4), threaded(0.4);
+    grid.build(positions.data(), count);
+    threaded.build(positions.data(), count, 4);
+
+    // the storage order does not depend on the number of threads
+    for (size_t k = 0; k < count; k++)
+        EXPECT_EQ(grid.values()[k], threaded.values()[k]);
+
+    for (size_t q = 0; q < 50; q++)
+    {
+        const double3d center = (random_vector<double3d>() - 0.5) * 12.0;
+        const double radius = 0.1 + random_scalar<double>() * 0.8;
+        std::vector<uint32_t> found, expected;
+
+        grid.for_each_in_radius(center, radius, [&](const double3d& position, const uint32_t index, const double distance2)
+        {
+            EXPECT_EQ(position, positions[index]);
+            EXPECT_DOUBLE_EQ(distance2, position.distance2(center));
+            found.push_back(index);
+        });
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (positions[i].distance2(center) <= radius * radius)
+                expected.push_back(i);
+        }
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+}
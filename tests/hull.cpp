@@ -0,0 +1,149 @@
+#include "common.h"
+#include <dandy/hull.h>
+#include <set>
+
+TEST(Hull, Predicates)
+{
+    EXPECT_EQ(orient2d(double2d(0, 0), double2d(1, 0), double2d(0, 1)), 1);
+    EXPECT_EQ(orient2d(double2d(0, 0), double2d(0, 1), double2d(1, 0)), -1);
+    EXPECT_EQ(orient2d(float2d(0, 0), float2d(1, 1), float2d(3, 3)), 0);
+
+    // points a unit in the last place off a line, where the determinant cancels out in double precision
+    const double2d a(0.5, 0.5), b(12, 12), c(24, 24);
+
+    for (int i = -4; i <= 4; i++)
+    {
+        const double2d p(0.5 + i * 0x1.0p-53, 0.5);
+        EXPECT_EQ(orient2d(p, b, c), i == 0 ? 0 : (i < 0 ? 1 : -1));
+    }
+    EXPECT_EQ(orient2d(a, b, c), 0);
+
+    EXPECT_EQ(orient3d(double3d(0, 0, 0), double3d(1, 0, 0), double3d(0, 1, 0), double3d(0, 0, 1)), 1);
+    EXPECT_EQ(orient3d(double3d(0, 0, 0), double3d(0, 1, 0), double3d(1, 0, 0), double3d(0, 0, 1)), -1);
+    EXPECT_EQ(orient3d(float3d(0, 0, 0), float3d(1, 0, 0), float3d(0, 1, 0), float3d(5, 7, 0)), 0);
+
+    // a point just off a large plane
+    EXPECT_EQ(orient3d(double3d(0, 0, 0), double3d(1e9, 0, 0), double3d(0, 1e9, 0), double3d(1e8, 1e8, 1e-8)), 1);
+    EXPECT_EQ(orient3d(double3d(0, 0, 0), double3d(1e9, 0, 0), double3d(0, 1e9, 0), double3d(1e8, 1e8, -1e-8)), -1);
+    EXPECT_EQ(orient3d(double3d(0.1, 0.1, 0.1), double3d(0.2, 0.2, 0.2), double3d(0.3, 0.7, 0.3), double3d(0.4, 0.1, 0.4)), 0);
+}
+
+TEST(Hull, Planar)
+{
+    // a square with points on its edges, duplicates and interior points
+    std::vector<float2d> points = { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 2, 2 }, { 0, 2 }, { 1, 1 }, { 2, 1 }, { 0, 0 }, { 0.5f, 1.5f } };
+    std::vector<uint32_t> hull;
+
+    convex_hull(points.data(), points.size(), hull);
+    EXPECT_EQ(hull, std::vector<uint32_t>({ 0, 2, 3, 4 }));
+
+    // collinear points
+    const double2d line[4] = { { 0, 0 }, { 3, 3 }, { 1, 1 }, { 2, 2 } };
+    std::vector<uint32_t> segment;
+    convex_hull(line, 4, segment);
+    EXPECT_EQ(segment, std::vector<uint32_t>({ 0, 1 }));
+
+    // points in a disc, hulled by brute force
+    constexpr size_t count = 20000;
+    std::vector<double2d> disc;
+
+    while (disc.size() < count)
+    {
+        const double2d p = random_vector<double2d>() * 2.0 - 1.0;
+
+        if (p.length2() <= 1)
+            disc.push_back(p);
+    }
+
+    std::vector<uint32_t> serial, threaded;
+    convex_hull(disc.data(), count, serial);
+    convex_hull(disc.data(), count, threaded, 4);
+
+    EXPECT_EQ(serial, threaded);
+    ASSERT_GE(serial.size(), 3u);
+
+    for (size_t k = 0; k < serial.size(); k++)
+    {
+        const double2d& a = disc[serial[k]];
+        const double2d& b = disc[serial[(k + 1) % serial.size()]];
+
+        for (const double2d& p : disc)
+            EXPECT_GE(orient2d(a, b, p), 0);
+    }
+}
+
+TEST(Hull, Spatial)
+{
+    // a cube with points on its faces and inside
+    std::vector<float3d> points;
+
+    for (int x = 0; x <= 2; x++)
+    {
+        for (int y = 0; y <= 2; y++)
+        {
+            for (int z = 0; z <= 2; z++)
+                points.emplace_back(float(x), float(y), float(z));
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> hull;
+    convex_hull(points.data(), points.size(), hull);
+
+    // 6 faces of 2 triangles over the corners, without the points on the faces and edges
+    std::set<uint32_t> vertices;
+
+    for (const auto& face : hull)
+    {
+        for (const uint32_t i : face)
+            vertices.insert(i);
+    }
+    EXPECT_EQ(vertices, std::set<uint32_t>({ 0, 2, 6, 8, 18, 20, 24, 26 }));
+    EXPECT_EQ(hull.size(), 12u);
+
+    // coplanar points have no hull
+    const double3d plane[4] = { { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 } };
+    convex_hull(plane, 4, hull);
+    EXPECT_TRUE(hull.empty());
+
+    // points in a ball: every point is behind every face, and every edge is shared by two faces
+    constexpr size_t count = 10000;
+    std::vector<double3d> ball;
+
+    while (ball.size() < count)
+    {
+        const double3d p = random_vector<double3d>() * 2.0 - 1.0;
+
+        if (p.length2() <= 1)
+            ball.push_back(p);
+    }
+
+    std::vector<std::array<uint32_t, 3>> serial, threaded;
+    convex_hull(ball.data(), count, serial);
+    convex_hull(ball.data(), count, threaded, 4);
+
+    EXPECT_EQ(serial, threaded);
+    ASSERT_GE(serial.size(), 4u);
+
+    std::multiset<std::pair<uint32_t, uint32_t>> edges;
+
+    for (const auto& face : serial)
+    {
+        for (size_t k = 0; k < 3; k++)
+            edges.emplace(face[k], face[(k + 1) % 3]);
+
+        for (const double3d& p : ball)
+            ASSERT_LE(orient3d(ball[face[0]], ball[face[1]], ball[face[2]], p), 0);
+    }
+    for (const auto& [from, to] : edges)
+    {
+        EXPECT_EQ(edges.count({ from, to }), 1u);
+        EXPECT_EQ(edges.count({ to, from }), 1u);
+    }
+
+    // Euler's formula for a triangulated sphere
+    std::set<uint32_t> ball_vertices;
+
+    for (const auto& face : serial)
+        ball_vertices.insert(face.begin(), face.end());
+    EXPECT_EQ(ball_vertices.size() + serial.size() - edges.size() / 2, 2u);
+}
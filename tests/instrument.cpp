@@ -0,0 +1,134 @@
+#include "common.h"
+
+// only compiled with DD_INSTRUMENT defined, as the `tests_instrument` target
+
+struct foreign_point
+{
+    float x, y, z;
+};
+
+template<>
+struct dd::converter<float3d, foreign_point>
+{
+    static void convert(const float3d& from, foreign_point& to)
+    {
+        to = { from[0], from[1], from[2] };
+    }
+
+    static void convert(const foreign_point& from, float3d& to)
+    {
+        to = { from.x, from.y, from.z };
+    }
+};
+
+TEST(Instrument, Evaluations)
+{
+    const float3d a { 1, 2, 3 };
+    const float3d b { 4, 5, 6 };
+    using sum_t = decltype(a + b);
+    using product_t = decltype((a + b) * a);
+
+    instrument::reset();
+
+    const float3d c = (a + b) * a;
+    EXPECT_EQ(c, float3d(5, 14, 27));
+
+    // each component of each operation is evaluated once
+    EXPECT_EQ(instrument::get<sum_t>().evaluations, 3u);
+    EXPECT_EQ(instrument::get<product_t>().evaluations, 3u);
+    EXPECT_EQ(instrument::get<product_t>().materializations, 1u);
+    EXPECT_EQ(instrument::get<sum_t>().materializations, 0u);
+
+    // values are loaded, not evaluated
+    EXPECT_EQ(instrument::get<float3d>().evaluations, 0u);
+}
+
+TEST(Instrument, Materializations)
+{
+    const float3d a { 1, 2, 3 };
+    using sum_t = decltype(a + a);
+
+    instrument::reset();
+
+    // length2 of an operation evaluates it into a temporary first
+    EXPECT_EQ((a + a).length2(), 56.f);
+    EXPECT_EQ(instrument::get<sum_t>().materializations, 1u);
+    EXPECT_EQ(a.length2(), 14.f);
+    EXPECT_EQ(instrument::get<float3d>().materializations, 0u);
+
+    // so does assigning to a view
+    float3d b = a;
+    b.xy() = b.yx();
+    EXPECT_EQ(instrument::get<decltype(b.yx())>().materializations, 1u);
+
+    // copies between values are not materializations
+    double3d c = a;
+    c = b;
+    EXPECT_EQ(instrument::get<float3d>().materializations, 0u);
+}
+
+TEST(Instrument, AlignedEvaluations)
+{
+    const aligned_vector<float, 3> a { 1, 2, 3 };
+    using sum_t = decltype(a + a);
+
+    instrument::reset();
+
+    // the padding component is evaluated alongside the three logical ones
+    const aligned_vector<float, 3> b = a + a;
+    EXPECT_EQ(b, float3d(2, 4, 6));
+    EXPECT_EQ(instrument::get<sum_t>().evaluations, 4u);
+    EXPECT_EQ(instrument::get<sum_t>().materializations, 1u);
+}
+
+TEST(Instrument, ConversionsAndHashes)
+{
+    const float3d a { 1, 2, 3 };
+
+    instrument::reset();
+
+    const foreign_point p = a;
+    const float3d b = p;
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(instrument::get<float3d>().conversions, 2u);
+
+    std::hash<float3d>()(a);
+    std::hash<float3d>()(b);
+    EXPECT_EQ(instrument::get<float3d>().hashes, 2u);
+}
+
+TEST(Instrument, SnapshotAndCallback)
+{
+    static size_t evaluations;
+    static size_t calls;
+    const int2d a { 1, 2 };
+
+    instrument::reset();
+    evaluations = calls = 0;
+    instrument::set_callback([](instrument::event kind, std::string_view type) {
+        EXPECT_EQ(type, instrument::type_name<decltype(a - a)>());
+        evaluations += kind == instrument::event::evaluation;
+        calls++;
+    });
+
+    const int2d b = a - a;
+    instrument::set_callback(nullptr);
+    EXPECT_EQ(b, int2d::zero);
+    EXPECT_EQ(evaluations, 2u);
+    EXPECT_EQ(calls, 3u);
+
+    const std::vector<instrument::counters> counters = instrument::snapshot();
+    ASSERT_EQ(counters.size(), 1u);
+    EXPECT_EQ(counters[0].type, instrument::type_name<decltype(a - a)>());
+    EXPECT_EQ(counters[0].evaluations, 2u);
+    EXPECT_EQ(counters[0].materializations, 1u);
+    EXPECT_NE(counters[0].type.find("operation"), std::string_view::npos);
+}
+
+TEST(Instrument, ConstantEvaluation)
+{
+    // nothing is recorded during constant evaluation
+    constexpr int2d a = int2d(1, 2) + int2d(3, 4);
+    static_assert(a[1] == 6);
+    EXPECT_EQ(instrument::type_name<int>(), "int");
+}
@@ -0,0 +1,119 @@
+#include "common.h"
+#include <dandy/kmeans.h>
+
+// plain Lloyd iterations from the given centroids, as the reference
+static std::vector<uint32_t> lloyd(const std::vector<float3d>& points, std::vector<float3d>& centroids, const size_t iterations)
+{
+    std::vector<uint32_t> labels(points.size());
+
+    for (size_t iteration = 0; iteration <= iterations; iteration++)
+    {
+        if (iteration > 0)
+        {
+            std::vector<double3d> sums(centroids.size());
+            std::vector<size_t> counts(centroids.size());
+
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                sums[labels[i]] += points[i];
+                counts[labels[i]]++;
+            }
+            for (size_t j = 0; j < centroids.size(); j++)
+            {
+                if (counts[j])
+                    centroids[j] = (sums[j] / double(counts[j])).scalar_cast<float>();
+            }
+        }
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            labels[i] = 0;
+
+            for (uint32_t j = 1; j < centroids.size(); j++)
+            {
+                if (points[i].distance2(centroids[j]) < points[i].distance2(centroids[labels[i]]))
+                    labels[i] = j;
+            }
+        }
+    }
+    return labels;
+}
+
+TEST(KMeans, Clusters)
+{
+    constexpr size_t count = 20000, k = 8;
+    std::vector<float3d> points(count), centers(k);
+    xoshiro256 rng(3);
+
+    for (size_t j = 0; j < k; j++)
+        centers[j] = float3d(float(j % 2), float(j / 2 % 2), float(j / 4)) * 10.f;
+    random_gaussian(rng, points.data(), count, float3d::zero, 0.5f);
+
+    for (size_t i = 0; i < count; i++)
+        points[i] += centers[i % k];
+
+    kmeans_options options;
+    options.seed = 7;
+    const kmeans_result<float, 3> result = kmeans(points.data(), count, k, options);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(result.labels.size(), count);
+
+    // the separated clusters are found, with points of the same cluster sharing a label
+    for (const float3d& center : centers)
+    {
+        float nearest = std::numeric_limits<float>::infinity();
+
+        for (const float3d& centroid : result.centroids)
+            nearest = std::min(nearest, centroid.distance2(center));
+        EXPECT_LT(nearest, 0.01f);
+    }
+    for (size_t i = k; i < count; i++)
+        EXPECT_EQ(result.labels[i], result.labels[i % k]);
+    EXPECT_NEAR(result.inertia / count, 3 * 0.25, 0.05);
+
+    // the same result from structure of arrays storage and on several threads
+    std::vector<float> x(count), y(count), z(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+    options.threads = 4;
+    const kmeans_result<float, 3> components = kmeans(std::array<const float*, 3>{ x.data(), y.data(), z.data() }, count, k, options);
+
+    EXPECT_EQ(components.labels, result.labels);
+    EXPECT_EQ(components.centroids, result.centroids);
+    EXPECT_EQ(components.inertia, result.inertia);
+}
+
+TEST(KMeans, Lloyd)
+{
+    constexpr size_t count = 10000, k = 20;
+    std::vector<float3d> points(count);
+    xoshiro256 rng(11);
+    random_in_box(rng, points.data(), count);
+
+    // the bounds skip work but do not change the iterations
+    kmeans_options options;
+    options.seed = 5;
+    options.max_iterations = 0;
+    std::vector<float3d> centroids = kmeans(points.data(), count, k, options).centroids;
+
+    options.max_iterations = 10;
+    options.threads = 3;
+    const kmeans_result<float, 3> result = kmeans(points.data(), count, k, options);
+    const std::vector<uint32_t> labels = lloyd(points, centroids, result.iterations);
+
+    EXPECT_FALSE(result.converged);
+    EXPECT_EQ(result.iterations, 10u);
+    EXPECT_EQ(labels, result.labels);
+
+    for (size_t j = 0; j < k; j++)
+        EXPECT_LT(centroids[j].distance(result.centroids[j]), 1e-5);
+
+    // fewer points than clusters
+    EXPECT_EQ(kmeans(points.data(), 3, k).centroids.size(), 3u);
+    EXPECT_TRUE(kmeans(points.data(), 0, k).centroids.empty());
+}
@@ -1,4 +1,5 @@
 #include "common.h"
+#include <array>
 
 template<class T>
 struct MathAll : testing::Test {};
@@ -92,3 +93,355 @@ TEST(Math, LinearAlgebra)
     // from angle
     EXPECT_EQ(double2d::from_angle(a.angle()), a);
 }
+
+TYPED_TEST(MathAll, MinMaxClamp)
+{
+    USING_TYPE_INFO
+
+    auto a = random_vector<vector_t>();
+    auto b = random_vector<vector_t>();
+    vector_t lo = *min(a, b);
+    vector_t hi = *max(a, b);
+    vector_t c = a.clamp(lo, hi);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        EXPECT_EQ(lo[i], std::min(a[i], b[i]));
+        EXPECT_EQ(hi[i], std::max(a[i], b[i]));
+        EXPECT_EQ(c[i], a[i]);
+    }
+    EXPECT_EQ(a.min(scalar_t(0)), vector_t::zero.min(a));
+    EXPECT_EQ(vector_t(a.clamp(0, 0)), vector_t::zero);
+}
+
+TEST(Math, MinMaxClampMixedSignedness)
+{
+    int2d a { -1, 5 };
+    uint2d b { 1, 3 };
+
+    testing::StaticAssertTypeEq<decltype(min(a, b).evaluate()), int2d>();
+    testing::StaticAssertTypeEq<decltype(max(a, b).evaluate()), uint2d>();
+    EXPECT_EQ(*min(a, b), int2d(-1, 3));
+    EXPECT_EQ(*max(a, b), uint2d(1, 5));
+    EXPECT_EQ(*a.clamp(0u, 4u), uint2d(0, 4));
+    EXPECT_EQ(*b.clamp(-2, 2), int2d(1, 2));
+    EXPECT_EQ(*min(uint2d(UINT32_MAX, 0), -1), int2d(-1, -1));
+}
+
+template<class T>
+struct MathFloating : testing::Test {};
+TYPED_TEST_SUITE(MathFloating, floating_vectors);
+
+TYPED_TEST(MathFloating, Elementwise)
+{
+    USING_TYPE_INFO
+
+    auto a = random_vector<vector_t>();
+    auto b = random_vector<vector_t>();
+    auto [sin, cos] = (a * 10).sincos();
+
+    for (size_t i = 0; i < size; i++)
+    {
+        EXPECT_NEAR(a.lerp(b, 0.25)[i], a[i] + (b[i] - a[i]) * 0.25, 1e-6);
+        EXPECT_NEAR(a.sqrt()[i], std::sqrt(a[i]), 1e-6);
+        EXPECT_NEAR((a * 10).exp()[i], std::exp(a[i] * 10), 1e-6 * std::exp(a[i] * 10));
+        EXPECT_NEAR((a * 10).sin()[i], std::sin(a[i] * 10), 1e-6);
+        EXPECT_NEAR((a * 10).cos()[i], std::cos(a[i] * 10), 1e-6);
+        EXPECT_NEAR(sin[i], std::sin(a[i] * 10), 1e-6);
+        EXPECT_NEAR(cos[i], std::cos(a[i] * 10), 1e-6);
+    }
+    EXPECT_EQ(lerp(a, b, 0), a);
+    EXPECT_EQ(lerp(a, b, 1), b);
+}
+
+TEST(Math, Kernels)
+{
+    float in[64], exp[64], sin[64], cos[64];
+
+    for (size_t i = 0; i < 64; i++)
+        in[i] = (i - 32.f) * 0.7f;
+
+    math::exp(in, exp, 64);
+    math::sincos(in, sin, cos, 64);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        EXPECT_FLOAT_EQ(exp[i], std::exp(in[i]));
+        EXPECT_NEAR(sin[i], std::sin(in[i]), 1e-7);
+        EXPECT_NEAR(cos[i], std::cos(in[i]), 1e-7);
+    }
+    // with the special cases of std::atan2; see Math.Atan2Ulp for the error bounds
+    for (size_t i = 0; i < 64; i++)
+    {
+        EXPECT_FLOAT_EQ(math::atan2(in[i], in[63 - i] * 1.3f), std::atan2(in[i], in[63 - i] * 1.3f));
+        EXPECT_DOUBLE_EQ(math::atan2(double(in[i]) * 1e-3, double(in[63 - i])), std::atan2(double(in[i]) * 1e-3, double(in[63 - i])));
+    }
+    const double special[] = { 0.0, -0.0, 1.0, -1.0, INFINITY, -INFINITY };
+
+    for (const double y : special)
+    {
+        for (const double x : special)
+        {
+            EXPECT_DOUBLE_EQ(math::atan2(y, x), std::atan2(y, x));
+            EXPECT_EQ(std::signbit(math::atan2(y, x)), std::signbit(std::atan2(y, x)));
+            EXPECT_FLOAT_EQ(math::atan2(float(y), float(x)), std::atan2(float(y), float(x)));
+        }
+    }
+    EXPECT_TRUE(std::isnan(math::atan2(double(NAN), 1.0)));
+    EXPECT_TRUE(std::isnan(math::atan2(1.f, float(NAN))));
+
+    // the precise policy is `std::atan2` itself
+    EXPECT_EQ(math::atan2(0.3, -0.7, dd::precise), std::atan2(0.3, -0.7));
+    EXPECT_EQ(math::atan2(0x1.176e5p+29f, 0x1.50f90ap+30f, dd::precise), std::atan2(0x1.176e5p+29f, 0x1.50f90ap+30f));
+
+    // the floor of the reductions, against `std::floor` including the sign of zero
+    for (const double x : { -0.0, 0.0, -0.5, 0.5, -1.0, 1.0, -2.5, 1e17, -1e17, -4503599627370495.5 })
+    {
+        EXPECT_EQ(math::_floor(x), std::floor(x));
+        EXPECT_EQ(std::signbit(math::_floor(x)), std::signbit(std::floor(x)));
+        EXPECT_EQ(math::_floor(float(x)), std::floor(float(x)));
+        EXPECT_EQ(std::signbit(math::_floor(float(x))), std::signbit(std::floor(float(x))));
+    }
+    EXPECT_TRUE(std::isnan(math::_floor(double(NAN))));
+
+    EXPECT_EQ(math::exp(1000.0), std::numeric_limits<double>::infinity());
+    EXPECT_EQ(math::exp(-1000.0), 0);
+    EXPECT_TRUE(std::isnan(math::exp(NAN)));
+    EXPECT_TRUE(std::isnan(math::exp(-double(NAN))));
+
+    // NaN lanes must not reach the exponent scaling, which would shift a negative value
+    const float nans[4] = { NAN, -NAN, 1, NAN };
+    float exps[4];
+    math::exp(nans, exps, 4);
+
+    EXPECT_TRUE(std::isnan(exps[0]) && std::isnan(exps[1]) && std::isnan(exps[3]));
+    EXPECT_FLOAT_EQ(exps[2], std::exp(1.f));
+}
+
+/// @brief Gets the error of `value` in units in the last place of `T` at `expected`
+template<class T>
+double ulp_error(const T value, const long double expected)
+{
+    const T rounded = static_cast<T>(expected);
+    const long double ulp = std::nextafter(std::abs(rounded), std::numeric_limits<T>::infinity()) - std::abs(rounded);
+    return static_cast<double>(std::abs(value - expected) / ulp);
+}
+
+TEST(Math, Atan2Ulp)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    std::uniform_int_distribution<int> exponent(-60, 60);
+    double float_error = 0, double_error = 0;
+
+    for (size_t i = 0; i < 100000; i++)
+    {
+        // a scale of its own for each coordinate, to cover all ratios between them
+        const double y = std::ldexp(dist(rng), exponent(rng) / (i % 4 + 1));
+        const double x = std::ldexp(dist(rng), exponent(rng) / (i % 4 + 1));
+
+        float_error = std::max(float_error, ulp_error(math::atan2(float(y), float(x)), std::atan2((long double)float(y), (long double)float(x))));
+        double_error = std::max(double_error, ulp_error(math::atan2(y, x), std::atan2((long double)y, (long double)x)));
+    }
+    EXPECT_LE(ulp_error(math::atan2(0x1.176e5p+29f, 0x1.50f90ap+30f), std::atan2(0x1.176e5p+29L, 0x1.50f90ap+30L)), 1);
+    EXPECT_LE(float_error, 1);
+
+    // the reference is precise enough only where `long double` is wider than `double`
+    if (std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits)
+    {
+        EXPECT_LE(double_error, 2);
+    }
+}
+
+TEST(Math, FastAngles)
+{
+    float2d vectors[64];
+    float fast[64], precise[64];
+    float2d from_fast[64];
+
+    for (size_t i = 0; i < 64; i++)
+        vectors[i] = float2d::from_angle(i * 0.1 - 3.2);
+
+    angles(vectors, fast, 64, dd::fast);
+    angles(vectors, precise, 64);
+    from_angles(fast, from_fast, 64, dd::fast);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        EXPECT_NEAR(fast[i], precise[i], 1e-5);
+        EXPECT_NEAR(from_fast[i].distance(vectors[i]), 0, 1e-5);
+        EXPECT_NEAR(vectors[i].delta_angle(vectors[0], dd::fast), vectors[i].delta_angle(vectors[0]), 1e-5);
+    }
+    EXPECT_DOUBLE_EQ(double2d(1, 0).angle(dd::fast), 0);
+    EXPECT_NEAR(double2d(-1, 0).angle(dd::fast), std::atan2(0, -1), 1e-6);
+    EXPECT_NEAR(double2d(0, -1).angle(dd::fast), std::atan2(-1, 0), 1e-6);
+    EXPECT_EQ(double2d::from_angle(0, dd::fast), double2d(1, 0));
+    EXPECT_DOUBLE_EQ(double2d(1, 1).delta_angle(double2d(2, 2)), 0);
+}
+
+TEST(Math, Coordinates)
+{
+    const double2d planar(-3, 4);
+    const double2d polar = planar.to_polar();
+
+    EXPECT_DOUBLE_EQ(polar[0], 5);
+    EXPECT_DOUBLE_EQ(polar[1], std::atan2(4, -3));
+    EXPECT_LT(double2d::from_polar(polar).distance(planar), 1e-14);
+
+    // the polar angle from the z-axis, then the azimuth from the x-axis
+    const double3d spherical = double3d(0, 2, 0).to_spherical();
+
+    EXPECT_DOUBLE_EQ(spherical[0], 2);
+    EXPECT_DOUBLE_EQ(spherical[1], std::acos(0));
+    EXPECT_DOUBLE_EQ(spherical[2], std::acos(0));
+    EXPECT_EQ(double3d(0, 0, -1).to_spherical(), double3d(1, std::acos(-1), 0));
+
+    // a scan of points, converted per point and by the array kernels
+    constexpr size_t count = 1000;
+    std::vector<float3d> points(count), precise(count), fast(count), back(count);
+
+    for (float3d& p : points)
+        p = random_vector<float3d>() * 200.f - 100.f;
+
+    to_spherical(points.data(), precise.data(), count);
+    to_spherical(points.data(), fast.data(), count, dd::fast);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const double3d expected = points[i].to_spherical();
+
+        EXPECT_LT(precise[i].distance(expected), 1e-4);
+        EXPECT_LT(fast[i].distance(expected), 1e-3);
+        EXPECT_LT(points[i].to_spherical(dd::fast).distance(expected), 1e-3);
+        EXPECT_LT(float3d::from_spherical(expected).distance(points[i]), 1e-4);
+        EXPECT_LT(float3d::from_spherical(expected, dd::fast).distance(points[i]), 1e-3);
+    }
+    from_spherical(precise.data(), back.data(), count);
+
+    for (size_t i = 0; i < count; i++)
+        EXPECT_LT(back[i].distance(points[i]), 1e-4);
+
+    from_spherical(fast.data(), back.data(), count, dd::fast);
+
+    for (size_t i = 0; i < count; i++)
+        EXPECT_LT(back[i].distance(points[i]), 1e-3);
+
+    std::vector<double2d> plane(count), polars(count), plane_back(count);
+
+    for (double2d& p : plane)
+        p = random_vector<double2d>() * 2.0 - 1.0;
+
+    to_polar(plane.data(), polars.data(), count);
+    from_polar(polars.data(), plane_back.data(), count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        EXPECT_LT(polars[i].distance(plane[i].to_polar()), 1e-15);
+        EXPECT_LT(plane_back[i].distance(plane[i]), 1e-15);
+    }
+}
+
+template<size_t Count>
+constexpr std::array<double2d, Count> make_directions()
+{
+    std::array<double2d, Count> out {};
+
+    for (size_t i = 0; i < Count; i++)
+        out[i] = double2d::from_angle(i * 6.283185307179586 / Count);
+    return out;
+}
+
+TEST(Math, ConstantEvaluation)
+{
+    // baked into the binary, compared against the run time implementations below
+    constexpr std::array<double2d, 16> directions = make_directions<16>();
+    constexpr double length = double3d(2, 3, 6).length();
+    constexpr double distance = int2d(1, 1).distance(int2d(4, 5));
+    constexpr double3d normal = float3d(1, 2, 2).normalize();
+    constexpr double angle = double2d(-1, 1).angle();
+    constexpr float fast_angle = float2d(-1, 1).angle(dd::fast);
+    constexpr double delta = double3d(1, 0, 0).delta_angle(double3d(1, 1, 0));
+    constexpr double3d roots = double3d(2, 0, 1e300).sqrt();
+
+    static_assert(length == 7 && distance == 5);
+
+    for (size_t i = 0; i < directions.size(); i++)
+    {
+        const double2d expected = double2d::from_angle(i * 6.283185307179586 / directions.size());
+
+        EXPECT_NEAR(directions[i][0], expected[0], 1e-15);
+        EXPECT_NEAR(directions[i][1], expected[1], 1e-15);
+        EXPECT_NEAR(directions[i].angle(), expected.angle(), 1e-15);
+    }
+    EXPECT_EQ(normal, double3d(1, 2, 2) / 3);
+    EXPECT_DOUBLE_EQ(angle, std::atan2(1, -1));
+    EXPECT_FLOAT_EQ(fast_angle, float2d(-1, 1).angle(dd::fast));
+    EXPECT_DOUBLE_EQ(delta, std::acos(1 / std::sqrt(2)));
+    EXPECT_EQ(roots[0], std::sqrt(2.0));
+    EXPECT_EQ(roots[1], 0);
+    EXPECT_EQ(roots[2], std::sqrt(1e300));
+}
+
+template<class T, size_t Count>
+constexpr std::array<T, Count> sqrt_inputs(const T ratio)
+{
+    std::array<T, Count> out {};
+    T x = T(1e-30);
+
+    // spread over many binades, with mantissas which do not repeat
+    for (size_t i = 0; i < Count; i++, x *= ratio)
+        out[i] = x + T(i) * x / T(Count);
+    return out;
+}
+
+template<class T, size_t Count>
+constexpr std::array<T, Count> constant_roots(const std::array<T, Count>& inputs)
+{
+    std::array<T, Count> out {};
+
+    for (size_t i = 0; i < Count; i++)
+        out[i] = dd::math::sqrt(inputs[i]);
+    return out;
+}
+
+TEST(Math, ConstantSqrt)
+{
+    constexpr std::array<double, 200> inputs = sqrt_inputs<double, 200>(1.7320508);
+    constexpr std::array<double, 200> roots = constant_roots(inputs);
+    constexpr std::array<float, 120> float_inputs = sqrt_inputs<float, 120>(2.1f);
+    constexpr std::array<float, 120> float_roots = constant_roots(float_inputs);
+
+    static_assert(dd::math::sqrt(4.0) == 2 && dd::math::sqrt(0.25f) == 0.5f);
+
+    for (size_t i = 0; i < inputs.size(); i++)
+        EXPECT_EQ(roots[i], std::sqrt(inputs[i])) << inputs[i];
+    for (size_t i = 0; i < float_inputs.size(); i++)
+        EXPECT_EQ(float_roots[i], std::sqrt(float_inputs[i])) << float_inputs[i];
+}
+
+TEST(Math, ConstantAtan2)
+{
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    static constexpr std::array<double, 7> coordinates = { 0.0, -0.0, 1.0, -1.0, 1e-300, inf, -inf };
+    constexpr size_t count = coordinates.size() * coordinates.size();
+
+    constexpr std::array<double, count> angles = []
+    {
+        std::array<double, count> out {};
+
+        for (size_t i = 0; i < count; i++)
+            out[i] = dd::math::atan2(coordinates[i / coordinates.size()], coordinates[i % coordinates.size()], dd::precise);
+        return out;
+    }();
+    constexpr double angle = double2d(-1, -0.0).angle();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const double y = coordinates[i / coordinates.size()], x = coordinates[i % coordinates.size()];
+        const double expected = std::atan2(y, x);
+
+        EXPECT_EQ(angles[i], expected) << "atan2(" << y << ", " << x << ")";
+        EXPECT_EQ(std::signbit(angles[i]), std::signbit(expected)) << "atan2(" << y << ", " << x << ")";
+    }
+    EXPECT_EQ(angle, double2d(-1, -0.0).angle());
+}
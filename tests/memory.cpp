@@ -0,0 +1,77 @@
+#include "common.h"
+#include <dandy/memory.h>
+#include <vector>
+
+TEST(Memory, AlignedAllocator)
+{
+    std::vector<float4d, aligned_allocator<float4d>> a(100);
+    std::vector<float3d, aligned_allocator<float3d, 16>> b(100);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 16, 0);
+
+    for (const float4d& v : a)
+        EXPECT_EQ(v, float4d::zero);
+}
+
+TEST(Memory, Arena)
+{
+    arena scratch(1024);
+
+    void* a = scratch.allocate(100);
+    void* b = scratch.allocate(100, 64);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(scratch.stats().bytes_in_use, 200);
+    EXPECT_EQ(scratch.stats().allocation_count, 2);
+
+    // the most recent allocation is reclaimed immediately
+    scratch.deallocate(b, 100);
+    EXPECT_EQ(scratch.stats().bytes_in_use, 100);
+    EXPECT_EQ(scratch.allocate(100, 64), b);
+
+    // others remain part of the frame until the reset
+    scratch.deallocate(a, 100);
+    EXPECT_EQ(scratch.stats().bytes_in_use, 200);
+
+    // outgrow the first block
+    scratch.allocate(4000);
+
+    EXPECT_EQ(scratch.stats().system_allocations, 2);
+    EXPECT_EQ(scratch.stats().high_water_mark, 4200);
+
+    scratch.reset();
+
+    EXPECT_EQ(scratch.stats().bytes_in_use, 0);
+    EXPECT_EQ(scratch.stats().allocation_count, 0);
+    EXPECT_EQ(scratch.stats().high_water_mark, 4200);
+    EXPECT_EQ(scratch.stats().system_allocations, 3);
+
+    // the same frame now fits without going to the system
+    scratch.allocate(100);
+    scratch.allocate(100, 64);
+    scratch.allocate(4000);
+
+    EXPECT_EQ(scratch.stats().system_allocations, 3);
+}
+
+TEST(Memory, ArenaAllocator)
+{
+    arena scratch;
+
+    for (size_t frame = 0; frame < 3; frame++)
+    {
+        std::vector<double3d, arena_allocator<double3d>> points(scratch);
+
+        for (size_t i = 0; i < 1000; i++)
+            points.push_back(double3d(i));
+
+        for (size_t i = 0; i < 1000; i++)
+            EXPECT_EQ(points[i], double3d(i));
+
+        EXPECT_GT(scratch.stats().bytes_in_use, 0);
+        scratch.reset();
+    }
+    EXPECT_LE(scratch.stats().system_allocations, 2);
+}
@@ -0,0 +1,75 @@
+// Compiled without including dandy.h, to check that `import dandy;` provides its API
+#include <gtest/gtest.h>
+#include <sstream>
+#include <unordered_set>
+import dandy;
+
+using namespace dd;
+
+TEST(Module, Expressions)
+{
+    float3d a { 1, 2, 3 };
+    const int3d b { 4, 5, 6 };
+    aligned_vector<float, 3> c = a * 2 + 1;
+
+    EXPECT_EQ(c, float3d(3, 5, 7));
+    EXPECT_EQ(*min(a, b), float3d(1, 2, 3));
+    EXPECT_EQ(*clamp(b, 4, 5), int3d(4, 5, 5));
+    EXPECT_EQ(a.zyx(), float3d(3, 2, 1));
+    EXPECT_EQ((slice<1, 3>(a)), float2d(2, 3));
+    EXPECT_EQ(a * constant<1>(), a);
+    EXPECT_FLOAT_EQ(a.length(), std::sqrt(14.f));
+    EXPECT_TRUE((traits::is_same_size_v<float3d, decltype(a + b)>));
+    EXPECT_EQ((traits::capacity_v<decltype(c)>), 4u);
+}
+
+TEST(Module, Introspection)
+{
+    const float3d a { 1, 2, 3 };
+    constexpr traits::expression_cost cost = traits::cost_v<decltype(a + a)>;
+
+    EXPECT_EQ(cost.loads, 2u);
+    EXPECT_EQ(traits::cost<decltype(a + a)>::value.ops, cost.ops);
+    EXPECT_EQ(describe(a + a), describe<decltype(a + a)>());
+    EXPECT_NE(describe(a + a).find("plus"), std::string::npos);
+}
+
+TEST(Module, Math)
+{
+    float2d directions[2] = { { 1, 0 }, { 0, 1 } };
+    float angle_values[2];
+    angles(directions, angle_values, 2, fast);
+
+    EXPECT_NEAR(angle_values[1], std::acos(0.f), 1e-5);
+    EXPECT_DOUBLE_EQ(math::atan2(1.0, 1.0, precise), std::atan2(1.0, 1.0));
+    EXPECT_NEAR(math::exp(1.f), std::exp(1.f), 1e-6);
+    EXPECT_EQ(math::sqrt(16.0), 4.0);
+
+    float2d polar[2];
+    float2d planar[2];
+    to_polar(directions, polar, 2);
+    from_polar(polar, planar, 2);
+
+    EXPECT_FLOAT_EQ(polar[1][1], std::acos(0.f));
+    EXPECT_LT(planar[1].distance(directions[1]), 1e-6);
+
+    const float3d points[1] = { { 0, 2, 0 } };
+    float3d spherical[1];
+    float3d back[1];
+    to_spherical(points, spherical, 1);
+    from_spherical(spherical, back, 1);
+
+    EXPECT_FLOAT_EQ(spherical[0][0], 2);
+    EXPECT_LT(back[0].distance(points[0]), 1e-6);
+}
+
+TEST(Module, StdIntegration)
+{
+    std::ostringstream stream;
+    stream << int2d(1, 2);
+
+    std::unordered_set<int2d> set { int2d(1, 2) };
+
+    EXPECT_FALSE(stream.str().empty());
+    EXPECT_EQ(set.count(int2d(1, 2)), 1u);
+}
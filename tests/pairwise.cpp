@@ -0,0 +1,48 @@
+#include "common.h"
+#include <dandy/pairwise.h>
+
+template<size_t Size>
+static void expect_pairwise(const size_t rows, const size_t columns, const size_t threads, const double tolerance)
+{
+    using vector_t = vector<double, Size>;
+    std::vector<vector_t> a(rows), b(columns);
+    std::vector<double> out(rows * columns, -1);
+
+    for (vector_t& v : a)
+        v = random_vector<vector_t>();
+    for (vector_t& v : b)
+        v = random_vector<vector_t>();
+    b[0] = a[0];
+
+    pairwise_distance2(a.data(), rows, b.data(), columns, out.data(), threads);
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        for (size_t j = 0; j < columns; j++)
+            EXPECT_NEAR(out[i * columns + j], a[i].distance2(b[j]), tolerance);
+    }
+    EXPECT_GE(out[0], 0);
+}
+
+TEST(Pairwise, Distance2)
+{
+    // counts which are not multiples of the row blocks and column tiles
+    expect_pairwise<3>(67, 301, 1, 1e-12);
+    expect_pairwise<2>(130, 17, 3, 1e-12);
+
+    // the expanded form of larger vectors
+    expect_pairwise<16>(67, 301, 1, 1e-10);
+    expect_pairwise<33>(5, 600, 2, 1e-10);
+
+    // integers are exact either way
+    const int3d a[2] = { { 1, 2, 3 }, { -4, 0, 2 } };
+    const int3d b[3] = { { 0, 0, 0 }, { 1, 2, 3 }, { 5, 5, 5 } };
+    int out[6];
+
+    pairwise_distance2(a, 2, b, 3, out);
+    EXPECT_EQ(out[0], 14);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 16 + 9 + 4);
+    EXPECT_EQ(out[3], 20);
+    EXPECT_EQ(out[5], 81 + 25 + 9);
+}
@@ -0,0 +1,69 @@
+#include "common.h"
+#include <dandy/parallel.h>
+#include <thread>
+
+TEST(Parallel, For)
+{
+    constexpr size_t count = 10007;
+    std::vector<int> visits(count);
+
+    // every index is visited once, in whole chunks of `grain` indices
+    parallel_for(count, 100, 4, [&](const size_t first, const size_t last, const size_t thread)
+    {
+        EXPECT_EQ(first % 100, 0u);
+        EXPECT_EQ(last, std::min(first + 100, count));
+        EXPECT_LT(thread, 4u);
+
+        for (size_t i = first; i < last; i++)
+            visits[i]++;
+    });
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), std::ptrdiff_t(count));
+
+    // a single thread and an empty range run on the calling thread
+    size_t calls = 0;
+    parallel_for(count, 0, 1, [&](size_t, size_t, const size_t thread) { calls++; EXPECT_EQ(thread, 0u); });
+    parallel_for(0, 100, 0, [&](size_t, size_t, size_t) { calls++; });
+    EXPECT_EQ(calls, count);
+}
+
+TEST(Parallel, Pool)
+{
+    constexpr size_t count = 1000;
+    std::atomic<size_t> threads = 0;
+
+    // the helper threads are kept between calls rather than started by each, so only the first
+    // calls see new threads; the pool is as large as the largest call of any test
+    for (size_t call = 0; call < 100; call++)
+    {
+        parallel_for(count, 10, 4, [&](size_t, size_t, size_t)
+        {
+            thread_local bool seen = false;
+
+            if (!std::exchange(seen, true))
+                threads++;
+        });
+    }
+    EXPECT_LE(threads, default_thread_count() + 4);
+
+    // calls nested in calls and from several threads at once run all their chunks
+    std::vector<std::atomic<int>> visits(count * count / 10);
+    const auto nested = [&]
+    {
+        parallel_for(count / 10, 1, 4, [&](const size_t outer, size_t, size_t)
+        {
+            parallel_for(count, 10, 3, [&](const size_t first, const size_t last, const size_t thread)
+            {
+                EXPECT_LT(thread, 3u);
+
+                for (size_t i = first; i < last; i++)
+                    visits[outer * count + i]++;
+            });
+        });
+    };
+    std::thread other(nested);
+    nested();
+    other.join();
+
+    for (const std::atomic<int>& v : visits)
+        EXPECT_EQ(v, 2);
+}
@@ -0,0 +1,94 @@
+#include "common.h"
+#include <dandy/particles.h>
+
+TEST(Particles, Storage)
+{
+    particle_system<float, 3> particles(3);
+
+    particles.set_position(1, { 1, 2, 3 });
+    particles.set_velocity(2, { 4, 5, 6 });
+    particles.forces(2)[0] = 7;
+
+    EXPECT_EQ(particles.position(1), float3d(1, 2, 3));
+    EXPECT_EQ(particles.positions(1)[1], 2);
+    EXPECT_EQ(particles.velocities(2)[2], 6);
+    EXPECT_EQ(particles.force(0), float3d(0, 0, 7));
+
+    // resizing keeps the particles
+    particles.resize(5);
+    EXPECT_EQ(particles.size(), 5u);
+    EXPECT_EQ(particles.position(1), float3d(1, 2, 3));
+    EXPECT_EQ(particles.velocity(2), float3d(4, 5, 6));
+    EXPECT_EQ(particles.position(4), float3d::zero);
+}
+
+TEST(Particles, Step)
+{
+    constexpr size_t count = 10000;
+    particle_system<double, 2> particles(count), threaded(count);
+    std::vector<double2d> x(count), v(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        x[i] = random_vector<double2d>();
+        v[i] = random_vector<double2d>() - 0.5;
+        particles.set_position(i, x[i]);
+        particles.set_velocity(i, v[i]);
+        particles.set_force(i, double2d(double(i % 3), 1));
+        threaded.set_position(i, x[i]);
+        threaded.set_velocity(i, v[i]);
+        threaded.set_force(i, double2d(double(i % 3), 1));
+    }
+
+    // a force and linear drag, as the expression API would write them one particle at a time
+    const double dt = 0.01, drag = 0.5;
+    const auto acceleration = [&](const auto& position, const auto& velocity, const auto& force) -> double2d
+    {
+        return force * 0.5 - velocity * drag + position.x;
+    };
+
+    particles.step(dt, acceleration);
+    threaded.step(dt, acceleration, integrator::semi_implicit_euler, 3);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const double2d force(double(i % 3), 1);
+        const double2d next_v = v[i] + (force * 0.5 - v[i] * drag + x[i].x) * dt;
+
+        EXPECT_EQ(particles.velocity(i), next_v);
+        EXPECT_EQ(particles.position(i), x[i] + next_v * dt);
+        EXPECT_EQ(threaded.position(i), particles.position(i));
+
+        // the previous state stays readable
+        EXPECT_EQ(particles.previous_positions(0)[i], x[i].x);
+        EXPECT_EQ(particles.previous_velocities(1)[i], v[i].y);
+    }
+}
+
+TEST(Particles, Orbit)
+{
+    // a quarter of a circular orbit around the origin with unit radius and speed; over whole periods
+    // the error of the first order method mostly cancels out
+    const auto gravity = [](const auto& position, const auto&, const auto&) -> double2d
+    {
+        const double length = position.length();
+        return -position / (length * length * length);
+    };
+    const size_t steps = 1571;
+    double errors[2];
+
+    for (const integrator method : { integrator::semi_implicit_euler, integrator::velocity_verlet })
+    {
+        particle_system<double, 2> particles(1);
+        particles.set_position(0, { 1, 0 });
+        particles.set_velocity(0, { 0, 1 });
+
+        for (size_t i = 0; i < steps; i++)
+            particles.step(0.001, gravity, method);
+        errors[size_t(method)] = particles.position(0).distance(double2d(std::cos(steps * 0.001), std::sin(steps * 0.001)));
+        EXPECT_NEAR(particles.position(0).length(), 1, 1e-3);
+    }
+
+    // the second order method stays much closer to the exact orbit
+    EXPECT_LT(errors[1] * 100, errors[0]);
+}
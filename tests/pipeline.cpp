@@ -0,0 +1,118 @@
+#include "common.h"
+#include <dandy/pipeline.h>
+#include <sstream>
+
+namespace
+{
+    std::string to_binary(const std::vector<float3d>& vectors)
+    {
+        return std::string(reinterpret_cast<const char*>(vectors.data()), vectors.size() * sizeof(float3d));
+    }
+
+    std::vector<float3d> from_binary(const std::string& bytes)
+    {
+        std::vector<float3d> out(bytes.size() / sizeof(float3d));
+
+        std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(out.data()));
+        return out;
+    }
+}
+
+TEST(Pipeline, Text)
+{
+    std::istringstream in("1 2 3\n-4.5, 5e1, 0.25\n(7, 8, 9)\r\n");
+    std::ostringstream out;
+
+    pipeline<float, 3> p;
+    p.then([](const float3d& v) -> float3d { return v * 2.f; }).then([](const float3d& v) -> float3d { return v.zyx(); });
+
+    const pipeline_result result = p.run(in, stream_format::text, out, stream_format::text);
+
+    EXPECT_EQ(result.status, pipeline_status::ok);
+    EXPECT_EQ(result.count, 3u);
+    EXPECT_EQ(out.str(), "6 4 2\n0.5 100 -9\n18 16 14\n");
+}
+
+TEST(Pipeline, Chunks)
+{
+    // enough vectors for several chunks and for numbers to straddle the text buffers
+    std::vector<float3d> vectors(20011);
+    std::ostringstream text;
+
+    for (size_t i = 0; i < vectors.size(); i++)
+    {
+        vectors[i] = float3d(float(i), float(i) * 0.5f, -float(i) / 4.f);
+        text << vectors[i].x << ' ' << vectors[i].y << ' ' << vectors[i].z << '\n';
+    }
+
+    const float3d offset(1, 2, 3);
+    std::string binary;
+
+    for (const size_t threads : { 1, 3 })
+    {
+        for (const size_t chunk_size : { 1, 7, 4096, 100000 })
+        {
+            pipeline<float, 3> p(chunk_size, threads);
+            p.then([&](const float3d& v) -> float3d { return v + offset; });
+
+            std::istringstream in(text.str());
+            std::ostringstream out;
+            const pipeline_result result = p.run(in, stream_format::text, out, stream_format::binary);
+
+            EXPECT_EQ(result.status, pipeline_status::ok);
+            EXPECT_EQ(result.count, vectors.size());
+
+            if (binary.empty())
+                binary = out.str();
+            else
+                EXPECT_EQ(out.str(), binary);
+        }
+    }
+
+    // binary back to text and the numbers read back exactly
+    const std::vector<float3d> transformed = from_binary(binary);
+    std::istringstream in(binary);
+    std::ostringstream out;
+
+    ASSERT_EQ(transformed.size(), vectors.size());
+    EXPECT_EQ((pipeline<float, 3>(1000).run(in, stream_format::binary, out, stream_format::text).status), pipeline_status::ok);
+
+    std::istringstream round_trip(out.str());
+    std::ostringstream back;
+
+    EXPECT_EQ((pipeline<float, 3>(333).run(round_trip, stream_format::text, back, stream_format::binary).count), vectors.size());
+    EXPECT_EQ(back.str(), binary);
+    for (size_t i = 0; i < vectors.size(); i++)
+        EXPECT_EQ(transformed[i], vectors[i] + offset);
+}
+
+TEST(Pipeline, Errors)
+{
+    pipeline<float, 3> p(2);
+    std::ostringstream out;
+
+    std::istringstream malformed("1 2 3\n4 5 6\n7 8 x\n");
+    const pipeline_result parse = p.run(malformed, stream_format::text, out, stream_format::text);
+
+    EXPECT_EQ(parse.status, pipeline_status::parse_error);
+    EXPECT_LE(parse.count, 2u);
+
+    std::istringstream incomplete("1 2 3 4");
+    EXPECT_EQ(p.run(incomplete, stream_format::text, out, stream_format::text).status, pipeline_status::parse_error);
+
+    std::istringstream truncated(to_binary({ float3d(1, 2, 3) }).substr(0, 10));
+    EXPECT_EQ(p.run(truncated, stream_format::binary, out, stream_format::text).status, pipeline_status::parse_error);
+
+    std::istringstream empty("");
+    const pipeline_result nothing = p.run(empty, stream_format::text, out, stream_format::text);
+
+    EXPECT_EQ(nothing.status, pipeline_status::ok);
+    EXPECT_EQ(nothing.count, 0u);
+
+    std::istringstream in("1 2 3");
+    std::ostringstream closed;
+    closed.setstate(std::ios::badbit);
+    EXPECT_EQ(p.run(in, stream_format::text, closed, stream_format::text).status, pipeline_status::write_error);
+
+    EXPECT_EQ(p.run("/nonexistent/input", stream_format::text, "/nonexistent/output", stream_format::text).status, pipeline_status::read_error);
+}
@@ -0,0 +1,136 @@
+#include "common.h"
+#include <dandy/random.h>
+
+TEST(Random, Streams)
+{
+    xoshiro256 a(42), b(42), c(42, 1), d(43);
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        const uint64_t x = a();
+
+        EXPECT_EQ(x, b());
+        EXPECT_NE(x, c());
+        EXPECT_NE(x, d());
+    }
+
+    // a stream is the generator advanced by long jumps
+    xoshiro256 e(42);
+    e.long_jump();
+    xoshiro256 f(42, 1);
+
+    for (size_t i = 0; i < 4; i++)
+        EXPECT_EQ(e.state()[i], f.state()[i]);
+
+    // usable with the standard distributions and at compile time
+    EXPECT_LT(std::uniform_int_distribution<int>(0, 9)(a), 10);
+    constexpr uint64_t first = xoshiro256(7)();
+    EXPECT_EQ(first, xoshiro256(7)());
+}
+
+TEST(Random, Lanes)
+{
+    xoshiro256x<4> batch(42, 3);
+    xoshiro256 lanes[4] = { xoshiro256(42, 3), xoshiro256(42, 3), xoshiro256(42, 3), xoshiro256(42, 3) };
+
+    for (size_t i = 1; i < 4; i++)
+    {
+        for (size_t j = i; j < 4; j++)
+            lanes[j].jump();
+    }
+
+    // single draws and bulk generation continue the same sequence, taking the lanes in turn
+    uint64_t bits[103];
+    EXPECT_EQ(batch(), lanes[0]());
+    batch.generate(bits, 103);
+
+    for (size_t i = 0; i < 103; i++)
+        EXPECT_EQ(bits[i], lanes[(i + 1) % 4]());
+    EXPECT_EQ(batch(), lanes[0]());
+}
+
+TEST(Random, Distributions)
+{
+    constexpr size_t count = 100000;
+    std::vector<float3d> points(count);
+    xoshiro256x<> rng(1);
+
+    random_in_box(rng, points.data(), count, float3d(-1, 0, 2), float3d(1, 1, 6));
+    double3d mean;
+
+    for (const float3d& p : points)
+    {
+        EXPECT_TRUE(p >= float3d(-1, 0, 2) && p <= float3d(1, 1, 6));
+        mean += p / double(count);
+    }
+    EXPECT_LT(mean.distance(double3d(0, 0.5, 4)), 0.02);
+
+    random_in_ball(rng, points.data(), count);
+    mean = double3d::zero;
+
+    for (const float3d& p : points)
+    {
+        EXPECT_LE(p.length2(), 1);
+        mean += p / double(count);
+    }
+    EXPECT_LT(mean.length(), 0.01);
+
+    random_on_sphere(rng, points.data(), count);
+    mean = double3d::zero;
+
+    for (const float3d& p : points)
+    {
+        EXPECT_NEAR(p.length(), 1, 1e-6);
+        mean += p / double(count);
+    }
+    EXPECT_LT(mean.length(), 0.01);
+
+    std::vector<double4d> gaussian(count);
+    random_gaussian(rng, gaussian.data(), count, double4d(1, 2, 3, 4), 2.0);
+    double4d sum, sum2;
+
+    for (const double4d& g : gaussian)
+    {
+        sum += g - double4d(1, 2, 3, 4);
+        sum2 += (g - double4d(1, 2, 3, 4)) * (g - double4d(1, 2, 3, 4));
+    }
+    for (size_t i = 0; i < 4; i++)
+    {
+        EXPECT_NEAR(sum[i] / count, 0, 0.03);
+        EXPECT_NEAR(sum2[i] / count, 4, 0.1);
+    }
+
+    std::vector<double4d> directions(count);
+    random_on_sphere(rng, directions.data(), count);
+
+    for (const double4d& d : directions)
+        EXPECT_NEAR(d.length(), 1, 1e-12);
+}
+
+TEST(Random, BlockSizes)
+{
+    // vectors larger than a block of draws are generated one at a time
+    std::vector<vector<double, 300>> large(3);
+    xoshiro256 rng(5);
+
+    random_in_box(rng, large.data(), large.size());
+    random_in_ball(rng, large.data(), 0);
+
+    for (const auto& v : large)
+        EXPECT_TRUE((v >= vector<double, 300>::zero && v <= vector<double, 300>::identity));
+
+    // 2D directions take one draw each, 3D directions two
+    xoshiro256 a(9), b(9);
+    std::vector<float2d> circle(1000);
+    std::vector<float3d> sphere(1000);
+
+    random_on_sphere(a, circle.data(), circle.size());
+    for (size_t i = 0; i < circle.size(); i++)
+        b();
+    EXPECT_EQ(a(), b());
+
+    random_on_sphere(a, sphere.data(), sphere.size());
+    for (size_t i = 0; i < 2 * sphere.size(); i++)
+        b();
+    EXPECT_EQ(a(), b());
+}
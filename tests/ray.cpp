@@ -0,0 +1,82 @@
+#include "common.h"
+#include <dandy/ray.h>
+
+// scalar Möller-Trumbore through the expression API, as the reference
+static bool reference_triangle(const float3d& o, const float3d& d, const float3d& v0, const float3d& v1, const float3d& v2, float& t)
+{
+    const float3d e1 = v1 - v0, e2 = v2 - v0;
+    const float3d p = d.cross(e2);
+    const float det = e1.dot(p);
+
+    if (det == 0)
+        return false;
+
+    const float3d s = o - v0;
+    const float3d q = s.cross(e1);
+    const float u = s.dot(p) / det, v = d.dot(q) / det;
+
+    t = e2.dot(q) / det;
+    return u >= 0 && v >= 0 && u + v <= 1 && t > 0;
+}
+
+TEST(Ray, Triangle)
+{
+    constexpr size_t lanes = 8;
+    float3d origins[lanes], directions[lanes];
+
+    for (size_t i = 0; i < lanes; i++)
+    {
+        origins[i] = float3d(random_scalar<float>(), random_scalar<float>(), -1.f) * 2.f;
+        directions[i] = float3d(0, 0, 1) + (float3d(random_scalar<float>(), random_scalar<float>(), 0.f) - 0.5f) * 0.2f;
+    }
+
+    const ray_packet<float, lanes> rays(origins, directions);
+    packet_hit<float, lanes> hit;
+    const float3d v0 { 0, 0, 1 }, v1 { 2, 0, 1.5f }, v2 { 0, 2, 1 };
+
+    const uint32_t mask = intersect_triangle(rays, v0, v1, v2, hit);
+
+    for (size_t i = 0; i < lanes; i++)
+    {
+        float t = 0;
+        const bool expected = reference_triangle(origins[i], directions[i], v0, v1, v2, t);
+
+        EXPECT_EQ(bool(mask & (1u << i)), expected);
+
+        if (expected)
+        {
+            const float3d point = origins[i] + directions[i] * hit.t[i];
+            const float3d barycentric = v0 * (1 - hit.u[i] - hit.v[i]) + v1 * hit.u[i] + v2 * hit.v[i];
+
+            EXPECT_NEAR(hit.t[i], t, 1e-5);
+            EXPECT_NEAR(point.distance(barycentric), 0, 1e-5);
+        }
+        else
+            EXPECT_EQ(hit.t[i], std::numeric_limits<float>::infinity());
+    }
+
+    // only closer hits replace the current ones
+    packet_hit<float, lanes> closer(0.5f);
+    EXPECT_EQ(intersect_triangle(rays, v0, v1, v2, closer), 0u);
+}
+
+TEST(Ray, Box)
+{
+    constexpr size_t lanes = 4;
+    const float3d origins[lanes] = { { -2, 0.5f, 0.5f }, { -2, 2, 0.5f }, { 0.5f, 0.5f, 0.5f }, { 2, 0.5f, 0.5f } };
+    const float3d directions[lanes] = { { 1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 } };
+
+    const ray_packet<float, lanes> rays(origins, directions);
+    const float t_max[lanes] = { 10, 10, 10, 10 };
+    float t_near[lanes];
+
+    const uint32_t mask = intersect_box(rays, float3d(0, 0, 0), float3d(1, 1, 1), t_max, t_near);
+
+    // hit from outside, miss beside, hit from inside, miss behind
+    EXPECT_EQ(mask, 0b0101u);
+    EXPECT_EQ(t_near[0], 2);
+    EXPECT_EQ(t_near[2], 0);
+
+    const float short_max[lanes] = { 1, 1, 1, 1 };
+    EXPECT_EQ(intersect_box(rays, float3d(0, 0, 0), float3d(1, 1, 1), short_max, t_near), 0b0100u);
+}
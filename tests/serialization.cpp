@@ -27,3 +27,25 @@ TEST(Serialization, Stream)
 
     EXPECT_EQ(stream.str(), "(0, -2)");
 }
+
+TEST(Serialization, Describe)
+{
+    float3d a;
+    aligned_vector<int32_t, 3> b;
+
+    EXPECT_EQ(describe((a + a) * 2.f),
+        "multiplies : vector<float, 3>\n"
+        "  plus : vector<float, 3>\n"
+        "    vector<float, 3>\n"
+        "    vector<float, 3>\n"
+        "  float\n");
+
+    EXPECT_EQ(describe(b.zx() << constant<1>()),
+        "shift_left : vector<int32_t, 2>\n"
+        "  view<2, 0> : vector<int32_t, 2>\n"
+        "    aligned_vector<int32_t, 3>\n"
+        "  constant<1>\n");
+
+    EXPECT_EQ(describe<float2d>(), "vector<float, 2>\n");
+    EXPECT_EQ(describe(a.apply([](float x) { return x; })), "apply : vector<float, 3>\n  vector<float, 3>\n");
+}
@@ -0,0 +1,96 @@
+#include "common.h"
+
+// also compiled with DD_FAST_MATH defined, as the `tests_fast_math` target
+
+TEST(Simplify, Identities)
+{
+    float3d a { 1, 2, 3 };
+    int3d b { 4, 5, 6 };
+    const auto c = a + a;
+    constant<1> one;
+    constant<0> zero;
+
+    // folded to the operand itself
+    testing::StaticAssertTypeEq<decltype(a * one), const float3d&>();
+    EXPECT_EQ(&(a * one), &a);
+    EXPECT_EQ(&(one * a), &a);
+    EXPECT_EQ(&(a / one), &a);
+    EXPECT_EQ(&(a - zero), &a);
+    EXPECT_EQ(&(-(-a)), &a);
+    EXPECT_EQ(&(+a), &a);
+    EXPECT_EQ(&(c * one), &c);
+    EXPECT_EQ(&(b + zero), &b);
+    EXPECT_EQ(&(zero + b), &b);
+    EXPECT_EQ(&(b | zero), &b);
+    EXPECT_EQ(&(b << zero), &b);
+    EXPECT_EQ(&(~~b), &b);
+
+    // the scalar type would change
+    vector<std::int8_t, 3> d { 1, 2, 3 };
+    EXPECT_TRUE(traits::is_operation_v<decltype(d * one)>);
+    EXPECT_TRUE(traits::is_operation_v<decltype(-(-d))>);
+    EXPECT_EQ((d * one).evaluate(), int3d(1, 2, 3));
+
+    // -0 + 0 is +0
+#ifdef DD_FAST_MATH
+    EXPECT_EQ(&(a + zero), &a);
+#else
+    EXPECT_TRUE(traits::is_operation_v<decltype(a + zero)>);
+#endif
+    EXPECT_EQ(a * constant<2>(), float3d(2, 4, 6));
+    EXPECT_EQ(b - constant<1>(), int3d(3, 4, 5));
+    EXPECT_EQ(-(-a + 1), float3d(0, 1, 2));
+}
+
+TEST(Simplify, ScalarChains)
+{
+    int3d a { 1, 2, 3 };
+    const auto b = (a * 2) * 3;
+    const auto c = 4 * (2 * a * 3);
+
+    testing::StaticAssertTypeEq<std::remove_const_t<decltype(b)>, impl::operation<impl::ops::multiplies, int3d, int>>();
+    EXPECT_EQ(&b.operand<0>(), &a);
+    EXPECT_EQ(b.operand<1>(), 6);
+    EXPECT_EQ(b, int3d(6, 12, 18));
+    EXPECT_EQ(c.operand<1>(), 24);
+    EXPECT_EQ(c, int3d(24, 48, 72));
+
+    // wraps around like the unmerged chain
+    uint3d u { 1, 2, 3 };
+    EXPECT_EQ((u * 0x10000u) * 0x10000u, uint3d(0, 0, 0));
+
+    float3d f { 1, 2, 3 };
+    using g_t = decltype((f * 2) * 3);
+#ifdef DD_FAST_MATH
+    testing::StaticAssertTypeEq<g_t, impl::operation<impl::ops::multiplies, float3d, float>>();
+#else
+    testing::StaticAssertTypeEq<g_t, impl::operation<impl::ops::multiplies, impl::operation<impl::ops::multiplies, float3d, int>, int>>();
+#endif
+    EXPECT_EQ((f * 2) * 3, float3d(6, 12, 18));
+}
+
+TEST(Simplify, Reciprocal)
+{
+    double3d a { 1, 2, 4 };
+    int3d b { 2, 4, 8 };
+    const auto c = a / 4.0;
+
+#ifdef DD_FAST_MATH
+    testing::StaticAssertTypeEq<std::remove_const_t<decltype(c)>, impl::operation<impl::ops::multiplies, double3d, double>>();
+#else
+    testing::StaticAssertTypeEq<std::remove_const_t<decltype(c)>, impl::operation<impl::ops::divides, double3d, double>>();
+#endif
+    EXPECT_EQ(c, double3d(0.25, 0.5, 1));
+    EXPECT_EQ(a * 2 / 4.0, double3d(0.5, 1, 2));
+    EXPECT_EQ(b / 2, int3d(1, 2, 4));
+}
+
+TEST(Simplify, ScalarOperandsByValue)
+{
+    double3d a { 1, 2, 3 };
+
+    // the scalar temporary is copied into the operation
+    const auto b = a * 2.0;
+
+    EXPECT_EQ(b + 1.0, double3d(3, 5, 7));
+}
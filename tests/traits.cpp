@@ -68,3 +68,18 @@ TYPED_TEST(TraitsAll, Prefabs)
     for (scalar_t s : vector_t::identity)
         EXPECT_EQ(s, 1);
 }
+
+TEST(Traits, Cost)
+{
+    using scaled_sum_t = decltype(std::declval<float3d>() * 2.f + std::declval<float3d>());
+    constexpr traits::expression_cost cost = traits::cost_v<scaled_sum_t>;
+    static_assert(cost.ops == 2 && cost.loads == 2 && cost.transcendentals == 0);
+
+    constexpr traits::expression_cost trig = traits::cost_v<decltype(std::declval<float3d>().sin() + std::declval<float3d>().zyx())>;
+    static_assert(trig.ops == 1 && trig.loads == 2 && trig.transcendentals == 1);
+
+    constexpr traits::expression_cost load = traits::cost_v<float3d>;
+    EXPECT_EQ(load.ops, 0u);
+    EXPECT_EQ(load.loads, 1u);
+    EXPECT_EQ(load.transcendentals, 0u);
+}
@@ -0,0 +1,118 @@
+#include "common.h"
+#include <dandy/random.h>
+#include <dandy/trajectory.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // a smooth path with some noise
+    std::vector<double3d> random_path(const size_t count)
+    {
+        std::vector<double3d> out(count);
+        xoshiro256 rng(7);
+        double3d position(100, -50, 3), velocity(1, 0, -0.5);
+
+        for (double3d& p : out)
+        {
+            double3d noise;
+            random_in_box(rng, &noise, 1);
+
+            velocity += (noise - 0.5) * 0.01;
+            position += velocity * 0.01;
+            p = position;
+        }
+        return out;
+    }
+}
+
+TEST(Trajectory, Exact)
+{
+    const std::vector<double3d> path = random_path(1000);
+
+    for (const trajectory_predictor predictor : { trajectory_predictor::delta, trajectory_predictor::linear })
+    {
+        compressed_trajectory<double, 3> trajectory(0, predictor);
+
+        for (const double3d& p : path)
+            trajectory.push_back(p);
+
+        EXPECT_EQ(trajectory.size(), 1000u);
+        EXPECT_EQ(trajectory.block_count(), 3u);
+
+        std::vector<double3d> decoded(path.size());
+        trajectory.decode(decoded.data());
+
+        EXPECT_EQ(std::memcmp(decoded.data(), path.data(), path.size() * sizeof(double3d)), 0);
+    }
+
+    // values which do not change smoothly
+    std::vector<float2d> values(600);
+
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = float2d(i % 3 ? -0.f : std::numeric_limits<float>::infinity(), i % 2 ? std::numeric_limits<float>::max() : -std::numeric_limits<float>::denorm_min());
+
+    compressed_trajectory<float, 2> trajectory;
+    trajectory.append(values.data(), values.size());
+
+    std::vector<float2d> decoded(values.size());
+    trajectory.decode(decoded.data());
+    EXPECT_EQ(std::memcmp(decoded.data(), values.data(), values.size() * sizeof(float2d)), 0);
+}
+
+TEST(Trajectory, Quantized)
+{
+    const std::vector<double3d> path = random_path(5000);
+    const double quantum = 1e-4;
+    compressed_trajectory<double, 3> trajectory(quantum);
+
+    trajectory.append(path.data(), path.size());
+
+    std::vector<double3d> decoded(path.size());
+    trajectory.decode(decoded.data(), 3);
+
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        for (size_t c = 0; c < 3; c++)
+            EXPECT_LE(std::abs(decoded[i][c] - path[i][c]), quantum * 0.5001);
+    }
+
+    // smooth motion compresses by more than 10x
+    EXPECT_LT(trajectory.bytes() * 10, path.size() * sizeof(double3d));
+}
+
+TEST(Trajectory, RandomAccess)
+{
+    std::vector<int3d> values(1000);
+    xoshiro256 rng(3);
+
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = int3d(int32_t(rng() % 1000) - 500, int32_t(i * i), i % 2 ? INT32_MIN : INT32_MAX);
+
+    compressed_trajectory<int32_t, 3> trajectory;
+
+    // appending in pieces which do not line up with the blocks
+    trajectory.append(values.data(), 100);
+    trajectory.append(values.data() + 100, 600);
+
+    for (size_t i = 700; i < values.size(); i++)
+        trajectory.push_back(values[i]);
+
+    ASSERT_EQ(trajectory.size(), values.size());
+
+    for (const auto& [first, count] : { std::pair<size_t, size_t>(0, 1000), { 10, 5 }, { 250, 300 }, { 511, 2 }, { 767, 233 }, { 999, 1 } })
+    {
+        std::vector<int3d> decoded(count);
+        trajectory.decode(first, count, decoded.data(), 2);
+
+        for (size_t i = 0; i < count; i++)
+            EXPECT_EQ(decoded[i], values[first + i]);
+    }
+    EXPECT_EQ(trajectory.get(300), values[300]);
+    EXPECT_EQ(trajectory.get(999), values[999]);
+
+    trajectory.clear();
+    EXPECT_EQ(trajectory.size(), 0u);
+    EXPECT_EQ(trajectory.bytes(), 0u);
+}
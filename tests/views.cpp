@@ -0,0 +1,90 @@
+#include "common.h"
+
+TEST(Views, Swizzle)
+{
+    double3d a { 1, 2, 3 };
+    const double3d b { 4, 5, 6 };
+
+    EXPECT_EQ(a.xy(), double2d(1, 2));
+    EXPECT_EQ(a.zyx(), double3d(3, 2, 1));
+    EXPECT_EQ(b.zx(), double2d(6, 4));
+    EXPECT_EQ(b.xxy(), double3d(4, 4, 5));
+    EXPECT_EQ((b.swizzle<2, 2, 1, 0>()), double4d(6, 6, 5, 4));
+    EXPECT_EQ((a + b).yz(), double2d(7, 9));
+    EXPECT_EQ(a.zyx().xy(), a.zy());
+
+    testing::StaticAssertTypeEq<decltype(a.zyx().xy()), decltype(a.zy())>();
+    EXPECT_TRUE(traits::is_view_v<decltype(a.xy())>);
+    EXPECT_TRUE(traits::is_expression_v<decltype(b.xy())>);
+    EXPECT_EQ(traits::size_v<decltype(a.zyx())>, 3);
+
+    // usable in operations without materializing
+    double2d c = a.xy() * 2 + b.yz();
+
+    EXPECT_EQ(c, double2d(7, 10));
+    EXPECT_DOUBLE_EQ(a.xy().length(), std::sqrt(5));
+    EXPECT_DOUBLE_EQ(b.yx().angle(), double2d(5, 4).angle());
+    EXPECT_EQ(b.yxz().cross(a), double3d(5, 4, 6).cross(a));
+    EXPECT_EQ((*a.zx()).to_string(), "(3.000000, 1.000000)");
+}
+
+TEST(Views, Slice)
+{
+    int4d a { 1, 2, 3, 4 };
+
+    EXPECT_EQ((slice<1, 3>(a)), int2d(2, 3));
+    EXPECT_EQ((a.slice<0, 3>()), int3d(1, 2, 3));
+    EXPECT_EQ((a.slice<1, 4>().slice<1, 3>()), int2d(3, 4));
+    testing::StaticAssertTypeEq<decltype(a.slice<1, 4>().slice<1, 3>()), decltype(a.zw())>();
+}
+
+TEST(Views, Assignment)
+{
+    int3d a { 1, 2, 3 };
+
+    a.xy() = int2d(5, 6);
+    EXPECT_EQ(a, int3d(5, 6, 3));
+
+    // overlapping assignment
+    a.xy() = a.yx();
+    EXPECT_EQ(a, int3d(6, 5, 3));
+
+    a.zyx() = a;
+    EXPECT_EQ(a, int3d(3, 5, 6));
+
+    a.yz() += int2d(1, 1);
+    a.xz() *= 2;
+    EXPECT_EQ(a, int3d(6, 6, 14));
+
+    a.yz()[0] = 0;
+    slice<1, 3>(a) -= int2d(0, 4);
+    EXPECT_EQ(a, int3d(6, 0, 10));
+
+    int4d b;
+    b.slice<1, 4>() = a;
+    EXPECT_EQ(b, int4d(0, 6, 0, 10));
+}
+
+TEST(Views, Aligned)
+{
+    aligned_vector<float, 3> a { 1, 2, 3 };
+
+    a.xy() = float2d(5, 6);
+    EXPECT_EQ(a, float3d(5, 6, 3));
+
+    a.zyx() = a;
+    EXPECT_EQ(a, float3d(3, 6, 5));
+
+    // views expose the logical components only, so the padding is neither read nor written
+    EXPECT_EQ((traits::capacity_v<decltype(a.zyx())>), 3);
+    EXPECT_EQ((traits::capacity_v<decltype(a + a.zyx())>), 3);
+
+    aligned_vector<float, 3> b = a.zyx();
+    aligned_vector<float, 3> c = a + b.zyx() * 2;
+
+    EXPECT_EQ(b, float3d(5, 6, 3));
+    EXPECT_EQ(c, float3d(9, 18, 15));
+    EXPECT_EQ(a.data[3], 0);
+    EXPECT_EQ(b.data[3], 0);
+    EXPECT_EQ(c.data[3], 0);
+}
@@ -0,0 +1,101 @@
+#include "common.h"
+#include <dandy/voxel.h>
+#include <map>
+
+TEST(Voxel, LowestBit)
+{
+    for (size_t i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(impl::_lowest_bit(uint64_t(1) << i), i);
+        EXPECT_EQ(impl::_lowest_bit(~uint64_t(0) << i), i);
+    }
+}
+
+TEST(Voxel, Grid)
+{
+    voxel_grid<float> grid(-1.f);
+    std::map<std::tuple<int, int, int>, float> reference;
+
+    // voxels on both sides of the origin, several per brick
+    for (size_t i = 0; i < 3000; i++)
+    {
+        const int3d voxel(int(random_scalar<uint32_t>() % 40) - 20, int(random_scalar<uint32_t>() % 40) - 20, int(random_scalar<uint32_t>() % 6) - 3);
+        const float value = float(i);
+
+        grid.set(voxel, value);
+        reference[{ voxel.x, voxel.y, voxel.z }] = value;
+    }
+    EXPECT_EQ(grid.size(), reference.size());
+    EXPECT_EQ(grid.get({ 100, 0, 0 }), -1.f);
+    EXPECT_EQ(grid.find({ 100, 0, 0 }), nullptr);
+
+    for (const auto& [key, value] : reference)
+    {
+        const int3d voxel(std::get<0>(key), std::get<1>(key), std::get<2>(key));
+
+        EXPECT_TRUE(grid.active(voxel));
+        EXPECT_EQ(grid.get(voxel), value);
+    }
+
+    // iteration visits each active voxel once, on any number of threads
+    for (const size_t threads : { 1, 3 })
+    {
+        std::atomic<size_t> visited = 0;
+
+        grid.for_each([&](const int3d& voxel, const float& value)
+        {
+            EXPECT_EQ(reference.at({ voxel.x, voxel.y, voxel.z }), value);
+            visited++;
+        }, threads);
+        EXPECT_EQ(visited, reference.size());
+    }
+
+    // neighbours through an accessor
+    voxel_grid<float>::accessor accessor(grid);
+
+    for (int x = -21; x <= 21; x++)
+    {
+        const int3d voxel(x, 0, 0);
+        const auto it = reference.find({ x, 0, 0 });
+
+        EXPECT_EQ(accessor.get(voxel), it == reference.end() ? -1.f : it->second);
+    }
+
+    // erasing all voxels of the lower half leaves empty bricks until pruned
+    const size_t bricks = grid.brick_count();
+
+    for (const auto& [key, value] : reference)
+    {
+        if (std::get<2>(key) < 0)
+        {
+            EXPECT_TRUE(grid.erase({ std::get<0>(key), std::get<1>(key), std::get<2>(key) }));
+        }
+    }
+    EXPECT_FALSE(grid.erase({ 0, 0, -1 }));
+    EXPECT_EQ(grid.brick_count(), bricks);
+
+    grid.prune();
+    EXPECT_LT(grid.brick_count(), bricks);
+
+    size_t remaining = 0;
+    grid.for_each_brick([&](const int3d& origin, const uint64_t* mask, float* values)
+    {
+        EXPECT_GE(origin.z, 0);
+
+        for (size_t i = 0; i < grid.brick_volume; i++)
+        {
+            const bool active = mask[i / 64] >> (i % 64) & 1;
+            const int3d voxel = origin + int3d(int(i % 8), int(i / 8 % 8), int(i / 64));
+            const auto it = reference.find({ voxel.x, voxel.y, voxel.z });
+
+            EXPECT_EQ(active, it != reference.end());
+            EXPECT_EQ(values[i], active ? it->second : -1.f);
+            remaining += active;
+        }
+    });
+    EXPECT_EQ(remaining, grid.size());
+
+    grid.clear();
+    EXPECT_EQ(grid.size(), 0u);
+    EXPECT_EQ(grid.get({ 0, 0, 0 }), -1.f);
+}